@@ -39,7 +39,10 @@ public class EasySettings : ModuleRules
 				"Slate",
 				"SlateCore",
 				"DeveloperSettings",
-				"DataSerializer"
+				"DataSerializer",
+				"RHI",
+				"RenderCore",
+				"Json"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
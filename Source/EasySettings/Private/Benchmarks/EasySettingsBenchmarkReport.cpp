@@ -0,0 +1,47 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmarks/EasySettingsBenchmarkReport.h"
+
+#include "EasySettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace EasySettingsBenchmark
+{
+	FReport::FReport(const FString& InBenchmark)
+		: Benchmark(InBenchmark)
+	{
+	}
+
+	void FReport::Add(const FString& InCase, const FString& InVariant, double InValue, const TCHAR* InUnit)
+	{
+		FRow& row = Rows.AddDefaulted_GetRef();
+		row.Case = InCase;
+		row.Variant = InVariant;
+		row.Value = InValue;
+		row.Unit = InUnit;
+	}
+
+	bool FReport::WriteCsv(const FString& InPath) const
+	{
+		const FString path = FPaths::IsRelative(InPath) ? FPaths::Combine(FPaths::ProfilingDir(), InPath) : InPath;
+
+		FString csv = TEXT("Benchmark,Case,Variant,Value,Unit\n");
+		for (const FRow& row : Rows)
+		{
+			csv += FString::Printf(TEXT("%s,%s,%s,%.3f,%s\n"), *Benchmark, *row.Case, *row.Variant, row.Value, *row.Unit);
+		}
+		if (!FFileHelper::SaveStringToFile(csv, *path))
+		{
+			UE_LOG(LogEasySettings, Warning, TEXT("Failed to write benchmark results to '%s'"), *path);
+			return false;
+		}
+		UE_LOG(LogEasySettings, Display, TEXT("Benchmark results written to '%s'"), *path);
+		return true;
+	}
+}
+
+#endif
@@ -0,0 +1,54 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace EasySettingsBenchmark
+{
+	template <typename FunctionType>
+	double MeasureNanosecondsPerOp(int64 InOps, FunctionType&& InFunction)
+	{
+		const double start = FPlatformTime::Seconds();
+		InFunction();
+		const double elapsed = FPlatformTime::Seconds() - start;
+		return elapsed * 1.0e9 / FMath::Max<int64>(InOps, 1);
+	}
+
+	/**
+	 * @brief Collects benchmark results and optionally writes them as CSV.
+	 *
+	 * Each row is `Benchmark,Case,Variant,Value,Unit`, so reports of several runs can be concatenated and compared.
+	 */
+	class FReport
+	{
+	public:
+		explicit FReport(const FString& InBenchmark);
+
+		void Add(const FString& InCase, const FString& InVariant, double InValue, const TCHAR* InUnit);
+
+		/**
+		 * @brief Writes the rows to a CSV file.
+		 *
+		 * @param InPath Target file, relative paths are resolved against the profiling directory.
+		 * @return true if the file was written.
+		 */
+		bool WriteCsv(const FString& InPath) const;
+
+	private:
+		struct FRow
+		{
+			FString Case;
+			FString Variant;
+			double Value = 0.0;
+			FString Unit;
+		};
+
+		FString Benchmark;
+		TArray<FRow> Rows;
+	};
+}
+
+#endif
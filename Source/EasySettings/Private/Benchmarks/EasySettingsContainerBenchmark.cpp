@@ -0,0 +1,170 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Benchmarks/EasySettingsBenchmarkReport.h"
+#include "Data/EasySettingsSetter.h"
+#include "EasySettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/EasySettingsTestSupport.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace EasySettingsContainerBenchmark
+{
+	using EasySettingsBenchmark::MeasureNanosecondsPerOp;
+	using namespace EasySettingsTestSupport;
+
+	/** The map based storage used before `EasySettings::FContainer`, kept as a baseline. */
+	typedef TMap<EasySettings::MapKey, EasySettings::MapValue> FLegacyContainer;
+
+	void Run(const TArray<FString>& InArgs)
+	{
+		int32 iterations = 10000;
+		if (InArgs.Num() > 0)
+		{
+			LexFromString(iterations, *InArgs[0]);
+		}
+		iterations = FMath::Max(iterations, 1);
+
+		const int32 n = EasySettings::VALUES_NUM;
+		const int64 ops = static_cast<int64>(iterations) * n;
+
+		FLegacyContainer legacy;
+		legacy.Reserve(n);
+		for (uint8 i = 0; i < n; ++i)
+		{
+			legacy.Add(i, 0.0f);
+		}
+
+		EasySettings::FContainer dense;
+		dense.Reset();
+
+		float sink = 0.0f;
+
+		// Get
+		const double legacyGet = MeasureNanosecondsPerOp(ops, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				for (uint8 i = 0; i < n; ++i)
+				{
+					if (legacy.Contains(i))
+					{
+						sink += legacy[i];
+					}
+				}
+			}
+		});
+		const double denseGet = MeasureNanosecondsPerOp(ops, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				for (uint8 i = 0; i < n; ++i)
+				{
+					if (const float* value = dense.Find(i))
+					{
+						sink += *value;
+					}
+				}
+			}
+		});
+
+		// Set
+		const double legacySet = MeasureNanosecondsPerOp(ops, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				for (uint8 i = 0; i < n; ++i)
+				{
+					if (legacy.Contains(i))
+					{
+						legacy[i] = static_cast<float>(it);
+					}
+				}
+			}
+		});
+		const double denseSet = MeasureNanosecondsPerOp(ops, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				for (uint8 i = 0; i < n; ++i)
+				{
+					if (dense.Contains(i))
+					{
+						dense[i] = static_cast<float>(it);
+					}
+				}
+			}
+		});
+
+		// Serialize round-trip. The baseline is the per-element `Write`/`Read` the setter used with the map; the setter
+		// row runs the setter's real `Write` and `TryRead`, including the header, typed values and checksum.
+		TArray<uint8> bytes;
+		bytes.Reserve(n * sizeof(float));
+		const double legacySerialize = MeasureNanosecondsPerOp(iterations, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				bytes.Reset();
+				FMemoryWriter writer(bytes);
+				for (TTuple<uint8, float>& el : legacy)
+				{
+					writer << el.Value;
+				}
+				FMemoryReader reader(bytes);
+				for (uint8 i = 0; i < n; ++i)
+				{
+					reader << legacy[i];
+				}
+			}
+		});
+		TStrongObjectPtr<UEasySettingsSetter> setter(NewObject<UEasySettingsSetter>(GetTransientPackage()));
+		FEasySettingsSchema schema;
+		BuildSchema(schema);
+		setter->SetSchema(&schema);
+		Fill(setter.Get());
+		bool bRead = true;
+		const double denseSerialize = MeasureNanosecondsPerOp(iterations, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				bytes.Reset();
+				FMemoryWriter writer(bytes);
+				setter->Write(writer);
+				FMemoryReader reader(bytes);
+				bRead &= setter->TryRead(reader) == EasySettings::EReadResult::Loaded;
+			}
+		});
+
+		UE_LOG(LogEasySettings, Display, TEXT("Container benchmark (%d iterations, %d keys, checksum %f)"), iterations, n, sink);
+		UE_LOG(LogEasySettings, Display, TEXT("  Get:       TMap %8.2f ns/op | dense %8.2f ns/op"), legacyGet, denseGet);
+		UE_LOG(LogEasySettings, Display, TEXT("  Set:       TMap %8.2f ns/op | dense %8.2f ns/op"), legacySet, denseSet);
+		UE_LOG(LogEasySettings, Display, TEXT("  Serialize: TMap %8.2f ns/container | setter %8.2f ns/container (%d bytes%s)"),
+		       legacySerialize, denseSerialize, bytes.Num(), bRead ? TEXT("") : TEXT(", READ FAILED"));
+
+		if (InArgs.Num() > 1)
+		{
+			EasySettingsBenchmark::FReport report(TEXT("Container"));
+			report.Add(TEXT("Get"), TEXT("TMap"), legacyGet, TEXT("ns/op"));
+			report.Add(TEXT("Get"), TEXT("Dense"), denseGet, TEXT("ns/op"));
+			report.Add(TEXT("Set"), TEXT("TMap"), legacySet, TEXT("ns/op"));
+			report.Add(TEXT("Set"), TEXT("Dense"), denseSet, TEXT("ns/op"));
+			report.Add(TEXT("Serialize"), TEXT("TMap"), legacySerialize, TEXT("ns/container"));
+			report.Add(TEXT("Serialize"), TEXT("Setter"), denseSerialize, TEXT("ns/container"));
+			report.WriteCsv(InArgs[1]);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("EasySettings.Benchmark.Container"),
+		TEXT("Measures get/set throughput of the settings container and the setter's Write/TryRead round-trip against the legacy TMap storage. ")
+		TEXT("Usage: EasySettings.Benchmark.Container [Iterations] [CsvPath]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -0,0 +1,139 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Benchmarks/EasySettingsBenchmarkReport.h"
+#include "Data/EasySettingsContainerLoader.h"
+#include "Data/EasySettingsContainerWriter.h"
+#include "EasySettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/EasySettingsTestSupport.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace EasySettingsPersistenceBenchmark
+{
+	using EasySettingsBenchmark::MeasureNanosecondsPerOp;
+	using namespace EasySettingsTestSupport;
+
+	void Run(const TArray<FString>& InArgs)
+	{
+		int32 iterations = 200;
+		if (InArgs.Num() > 0)
+		{
+			LexFromString(iterations, *InArgs[0]);
+		}
+		iterations = FMath::Max(iterations, 1);
+
+		TStrongObjectPtr<UEasySettingsSetter> source(NewObject<UEasySettingsSetter>(GetTransientPackage()));
+		TStrongObjectPtr<UEasySettingsSetter> target(NewObject<UEasySettingsSetter>(GetTransientPackage()));
+		FEasySettingsSchema schema;
+		BuildSchema(schema);
+		source->SetSchema(&schema);
+		target->SetSchema(&schema);
+		Fill(source.Get());
+
+		const FString directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("EasySettingsBenchmark"));
+		const FString path = FPaths::Combine(directory, TEXT("Container.bin"));
+		const FString journalPath = FPaths::Combine(directory, TEXT("Container.journal"));
+
+		// Serialize
+		TArray<uint8> bytes;
+		const double serialize = MeasureNanosecondsPerOp(iterations, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				bytes.Reset();
+				FMemoryWriter writer(bytes);
+				source->Write(writer);
+			}
+		});
+
+		// Compress and write, the same atomic replace the subsystem uses
+		bool bWritten = true;
+		const double compressWrite = MeasureNanosecondsPerOp(iterations, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				bWritten &= FEasySettingsContainerWriter::WriteSnapshot(bytes, path);
+			}
+		});
+
+		// Deserialize only
+		const double deserialize = MeasureNanosecondsPerOp(iterations, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				ReadBytes(target.Get(), bytes);
+			}
+		});
+
+		// Startup load: read and decompress the file, then deserialize it
+		EasySettings::EReadResult loadResult = EasySettings::EReadResult::Failed;
+		const double load = MeasureNanosecondsPerOp(iterations, [&]()
+		{
+			for (int32 it = 0; it < iterations; ++it)
+			{
+				FEasySettingsContainerLoader::FResult result = FEasySettingsContainerLoader::Load(path, journalPath);
+				loadResult = result.bReadSucceeded
+					             ? ReadBytes(target.Get(), result.Bytes)
+					             : EasySettings::EReadResult::Failed;
+			}
+		});
+
+		// Integrity checks, so a faster format never trades away robustness unnoticed
+		const bool bRoundTrip = bWritten && loadResult == EasySettings::EReadResult::Loaded
+			&& HasSameValues(source.Get(), target.Get());
+
+		TArray<uint8> truncated(bytes.GetData(), bytes.Num() / 2);
+		const bool bTruncatedRejected = ReadBytes(target.Get(), truncated) == EasySettings::EReadResult::Failed;
+
+		TArray<uint8> corrupted = bytes;
+		corrupted[corrupted.Num() / 4] ^= 0xFF;
+		const bool bCorruptedRejected = ReadBytes(target.Get(), corrupted) == EasySettings::EReadResult::Failed;
+
+		IFileManager::Get().DeleteDirectory(*directory, false, true);
+
+		const double toMicroseconds = 1.0e-3;
+		UE_LOG(LogEasySettings, Display, TEXT("Persistence benchmark (%d iterations, %d bytes)"), iterations, bytes.Num());
+		UE_LOG(LogEasySettings, Display, TEXT("  Serialize:          %10.2f us"), serialize * toMicroseconds);
+		UE_LOG(LogEasySettings, Display, TEXT("  Compress and write: %10.2f us"), compressWrite * toMicroseconds);
+		UE_LOG(LogEasySettings, Display, TEXT("  Deserialize:        %10.2f us"), deserialize * toMicroseconds);
+		UE_LOG(LogEasySettings, Display, TEXT("  Startup load:       %10.2f us"), load * toMicroseconds);
+		UE_LOG(LogEasySettings, Display, TEXT("  Round-trip: %s | truncated rejected: %s | corrupted rejected: %s"),
+		       bRoundTrip ? TEXT("yes") : TEXT("NO"), bTruncatedRejected ? TEXT("yes") : TEXT("NO"),
+		       bCorruptedRejected ? TEXT("yes") : TEXT("NO"));
+		if (!bRoundTrip || !bTruncatedRejected || !bCorruptedRejected)
+		{
+			UE_LOG(LogEasySettings, Error, TEXT("Persistence benchmark integrity checks failed"));
+		}
+
+		if (InArgs.Num() > 1)
+		{
+			EasySettingsBenchmark::FReport report(TEXT("Persistence"));
+			report.Add(TEXT("Serialize"), TEXT("Dense"), serialize * toMicroseconds, TEXT("us/container"));
+			report.Add(TEXT("CompressWrite"), TEXT("Dense"), compressWrite * toMicroseconds, TEXT("us/container"));
+			report.Add(TEXT("Deserialize"), TEXT("Dense"), deserialize * toMicroseconds, TEXT("us/container"));
+			report.Add(TEXT("StartupLoad"), TEXT("Dense"), load * toMicroseconds, TEXT("us/container"));
+			report.Add(TEXT("Size"), TEXT("Dense"), bytes.Num(), TEXT("bytes"));
+			report.Add(TEXT("RoundTrip"), TEXT("Check"), bRoundTrip ? 1.0 : 0.0, TEXT("pass"));
+			report.Add(TEXT("TruncatedRejected"), TEXT("Check"), bTruncatedRejected ? 1.0 : 0.0, TEXT("pass"));
+			report.Add(TEXT("CorruptedRejected"), TEXT("Check"), bCorruptedRejected ? 1.0 : 0.0, TEXT("pass"));
+			report.WriteCsv(InArgs[1]);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("EasySettings.Benchmark.Persistence"),
+		TEXT("Measures serialize, compress and write, and startup load time of the settings container, ")
+		TEXT("and checks that round-trips succeed and truncated or corrupted data is rejected. ")
+		TEXT("Usage: EasySettings.Benchmark.Persistence [Iterations] [CsvPath]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -0,0 +1,71 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsConsoleVariable.h"
+
+FEasySettingsConsoleVariable::FEasySettingsConsoleVariable(const FString& InName)
+	: Name(InName)
+{
+}
+
+bool FEasySettingsConsoleVariable::Resolve() const
+{
+	if (Variable)
+	{
+		return true;
+	}
+	if (Name.IsEmpty())
+	{
+		return false;
+	}
+	// The variable may be registered by a module that is loaded later, so keep trying until it is found
+	Variable = IConsoleManager::Get().FindConsoleVariable(*Name);
+	return Variable != nullptr;
+}
+
+int32 FEasySettingsConsoleVariable::GetInt(int32 InDefault) const
+{
+	return Resolve() ? Variable->GetInt() : InDefault;
+}
+
+float FEasySettingsConsoleVariable::GetFloat(float InDefault) const
+{
+	return Resolve() ? Variable->GetFloat() : InDefault;
+}
+
+bool FEasySettingsConsoleVariable::GetBool(bool bInDefault) const
+{
+	return Resolve() ? Variable->GetBool() : bInDefault;
+}
+
+bool FEasySettingsConsoleVariable::SetInt(int32 InValue, EConsoleVariableFlags InSetBy) const
+{
+	if (!Resolve())
+	{
+		return false;
+	}
+	Variable->Set(InValue, InSetBy);
+	// The console manager ignores writes below the priority of the current value
+	return Variable->GetInt() == InValue;
+}
+
+bool FEasySettingsConsoleVariable::SetFloat(float InValue, EConsoleVariableFlags InSetBy) const
+{
+	if (!Resolve())
+	{
+		return false;
+	}
+	Variable->Set(InValue, InSetBy);
+	// The value goes through its string form, which keeps six decimals
+	return FMath::IsNearlyEqual(Variable->GetFloat(), InValue, 1.e-5f * FMath::Max(1.0f, FMath::Abs(InValue)));
+}
+
+bool FEasySettingsConsoleVariable::SetBool(bool bInValue, EConsoleVariableFlags InSetBy) const
+{
+	if (!Resolve())
+	{
+		return false;
+	}
+	Variable->Set(bInValue, InSetBy);
+	return Variable->GetBool() == bInValue;
+}
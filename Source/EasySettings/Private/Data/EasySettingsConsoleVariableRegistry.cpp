@@ -0,0 +1,81 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsConsoleVariableRegistry.h"
+
+#include "EasySettings.h"
+
+void FEasySettingsConsoleVariableRegistry::Build(const TArray<FEasySettingsConsoleVariableEntry>& InEntries)
+{
+	Entries.Reset(InEntries.Num());
+	Variables.Reset(InEntries.Num());
+	IndexByName.Reset();
+
+	for (const FEasySettingsConsoleVariableEntry& entry : InEntries)
+	{
+		if (entry.Name.IsNone() || entry.ConsoleVariable.IsEmpty())
+		{
+			continue;
+		}
+		if (IndexByName.Contains(entry.Name))
+		{
+			UE_LOG(LogEasySettings, Warning, TEXT("Duplicate console variable setting '%s' ignored"), *entry.Name.ToString());
+			continue;
+		}
+
+		const int32 index = Entries.Add(entry);
+		Variables.Emplace(entry.ConsoleVariable);
+		IndexByName.Add(entry.Name, index);
+
+		if (!Variables[index].Resolve())
+		{
+			UE_LOG(LogEasySettings, Verbose, TEXT("Console variable '%s' is not registered yet"), *entry.ConsoleVariable);
+		}
+	}
+}
+
+int32 FEasySettingsConsoleVariableRegistry::FindIndex(FName InName) const
+{
+	const int32* index = IndexByName.Find(InName);
+	return index ? *index : INDEX_NONE;
+}
+
+float FEasySettingsConsoleVariableRegistry::Sanitize(int32 InIndex, float InValue) const
+{
+	const FEasySettingsConsoleVariableEntry& entry = Entries[InIndex];
+	float value = FMath::IsFinite(InValue) ? InValue : entry.Default;
+	value = FMath::Clamp(value, FMath::Min(entry.Min, entry.Max), FMath::Max(entry.Min, entry.Max));
+
+	switch (entry.Type)
+	{
+	case EEasySettingsConsoleVariableType::Int: return FMath::RoundToFloat(value);
+	case EEasySettingsConsoleVariableType::Bool: return value != 0.0f ? 1.0f : 0.0f;
+	default: return value;
+	}
+}
+
+float FEasySettingsConsoleVariableRegistry::GetValue(int32 InIndex) const
+{
+	const FEasySettingsConsoleVariable& variable = Variables[InIndex];
+	const FEasySettingsConsoleVariableEntry& entry = Entries[InIndex];
+
+	switch (entry.Type)
+	{
+	case EEasySettingsConsoleVariableType::Int: return variable.GetInt(FMath::RoundToInt(entry.Default));
+	case EEasySettingsConsoleVariableType::Bool: return variable.GetBool(entry.Default != 0.0f) ? 1.0f : 0.0f;
+	default: return variable.GetFloat(entry.Default);
+	}
+}
+
+bool FEasySettingsConsoleVariableRegistry::SetValue(int32 InIndex, float InValue) const
+{
+	const FEasySettingsConsoleVariable& variable = Variables[InIndex];
+	const float value = Sanitize(InIndex, InValue);
+
+	switch (Entries[InIndex].Type)
+	{
+	case EEasySettingsConsoleVariableType::Int: return variable.SetInt(FMath::RoundToInt(value));
+	case EEasySettingsConsoleVariableType::Bool: return variable.SetBool(value != 0.0f);
+	default: return variable.SetFloat(value);
+	}
+}
@@ -0,0 +1,77 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsContainerLoader.h"
+
+#include "Data/EasySettingsContainerWriter.h"
+#include "EasySettings.h"
+#include "EasySettingsStats.h"
+#include "HAL/FileManager.h"
+#include "Libs/DataSerializerLib.h"
+#include "Misc/FileHelper.h"
+
+FEasySettingsContainerLoader::FEasySettingsContainerLoader(const FString& InPath)
+	: Path(InPath)
+{
+}
+
+TSharedRef<FEasySettingsContainerLoader, ESPMode::ThreadSafe> FEasySettingsContainerLoader::Start(const FString& InPath,
+	const FString& InJournalPath)
+{
+	TSharedRef<FEasySettingsContainerLoader, ESPMode::ThreadSafe> loader = MakeShareable(
+		new FEasySettingsContainerLoader(InPath));
+	loader->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [InPath, InJournalPath]()
+	{
+		return Load(InPath, InJournalPath);
+	});
+	return loader;
+}
+
+TSharedRef<FEasySettingsContainerLoader, ESPMode::ThreadSafe> FEasySettingsContainerLoader::FromResult(
+	const FString& InPath, FResult&& InResult)
+{
+	TSharedRef<FEasySettingsContainerLoader, ESPMode::ThreadSafe> loader = MakeShareable(
+		new FEasySettingsContainerLoader(InPath));
+	loader->LoadedResult.Emplace(MoveTemp(InResult));
+	return loader;
+}
+
+FEasySettingsContainerLoader::FResult FEasySettingsContainerLoader::Load(const FString& InPath,
+                                                                         const FString& InJournalPath)
+{
+	EASYSETTINGS_PHASE_SCOPE(ReadDecompress);
+	FResult result;
+	result.bFileExists = FPaths::FileExists(InPath);
+	if (result.bFileExists)
+	{
+		result.bReadSucceeded = UDataSerializerLib::ReadCompressedBytesFromDisk(result.Bytes, InPath);
+	}
+	if (!result.bReadSucceeded)
+	{
+		// A save interrupted between its renames leaves the new file as the temporary one and the previous one as the
+		// backup. A complete temporary file is always newer than the backup.
+		const FString candidates[] = {
+			FEasySettingsContainerWriter::GetTempPath(InPath), FEasySettingsContainerWriter::GetBackupPath(InPath)
+		};
+		for (const FString& candidate : candidates)
+		{
+			if (!FPaths::FileExists(candidate) || !UDataSerializerLib::ReadCompressedBytesFromDisk(result.Bytes, candidate))
+				continue;
+
+			UE_LOG(LogEasySettings, Warning, TEXT("Container '%s' is missing or unreadable, recovered from '%s'"),
+			       *InPath, *candidate);
+			result.bFileExists = true;
+			result.bReadSucceeded = true;
+			result.RecoveredFrom = candidate;
+			IFileManager::Get().Copy(*InPath, *candidate);
+			break;
+		}
+	}
+	// The temporary file is a snapshot taken after every journal record, replaying them would revert newer values
+	const bool bRecoveredSnapshot = result.RecoveredFrom == FEasySettingsContainerWriter::GetTempPath(InPath);
+	if (!bRecoveredSnapshot && FPaths::FileExists(InJournalPath))
+	{
+		FFileHelper::LoadFileToArray(result.JournalBytes, *InJournalPath, FILEREAD_Silent);
+	}
+	return result;
+}
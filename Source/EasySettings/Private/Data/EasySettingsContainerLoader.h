@@ -0,0 +1,91 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * @brief Reads and decompresses a container file on a background task.
+ *
+ * The result only holds raw bytes; deserializing them into a `UEasySettingsSetter` happens on the game thread.
+ */
+class FEasySettingsContainerLoader : public TSharedFromThis<FEasySettingsContainerLoader, ESPMode::ThreadSafe>
+{
+public:
+	/** Raw outcome of reading the container file. */
+	struct FResult
+	{
+		/** True if the file, or a copy it could be recovered from, was found on disk. */
+		bool bFileExists = false;
+
+		/** True if the file was read and decompressed. */
+		bool bReadSucceeded = false;
+
+		/** Decompressed container bytes. */
+		TArray<uint8> Bytes;
+
+		/** Raw journal records, empty if there is no journal. */
+		TArray<uint8> JournalBytes;
+
+		/** The temporary or backup file the container was recovered from, empty if the file itself was read. */
+		FString RecoveredFrom;
+	};
+
+	/**
+	 * @brief Starts loading the given files on a background task.
+	 *
+	 * @param InPath Container file path.
+	 * @param InJournalPath Journal file path.
+	 * @return The loader tracking the request.
+	 */
+	static TSharedRef<FEasySettingsContainerLoader, ESPMode::ThreadSafe> Start(const FString& InPath,
+	                                                                          const FString& InJournalPath);
+
+	/**
+	 * @brief Reads and decompresses the given files on the calling thread.
+	 *
+	 * If the container is missing or cannot be read, the temporary file of an interrupted save and then the backup of
+	 * the previous save are tried, see `FEasySettingsContainerWriter::WriteSnapshot`. A recovered copy is put back in
+	 * place of the container.
+	 *
+	 * @param InPath Container file path.
+	 * @param InJournalPath Journal file path.
+	 * @return The raw outcome.
+	 */
+	static FResult Load(const FString& InPath, const FString& InJournalPath);
+
+	/**
+	 * @brief Wraps an outcome that was already loaded, so it can be handed over like a background read.
+	 *
+	 * The outcome is stored as is, no task is launched.
+	 *
+	 * @param InPath Container file path.
+	 * @param InResult The raw outcome of `Load`.
+	 * @return A loader that is already complete.
+	 */
+	static TSharedRef<FEasySettingsContainerLoader, ESPMode::ThreadSafe> FromResult(const FString& InPath,
+	                                                                               FResult&& InResult);
+
+	/** Checks whether the background read has finished. */
+	bool IsComplete() const { return LoadedResult.IsSet() || Task.IsCompleted(); }
+
+	/**
+	 * @brief Blocks until the background read has finished.
+	 *
+	 * @return The raw outcome. Bytes may be moved out by the caller.
+	 */
+	FResult& Wait() { return LoadedResult.IsSet() ? LoadedResult.GetValue() : Task.GetResult(); }
+
+	/** The file being loaded. */
+	const FString& GetPath() const { return Path; }
+
+private:
+	explicit FEasySettingsContainerLoader(const FString& InPath);
+
+	FString Path;
+	UE::Tasks::TTask<FResult> Task;
+
+	/** The outcome handed to `FromResult`, unset for a background read. */
+	TOptional<FResult> LoadedResult;
+};
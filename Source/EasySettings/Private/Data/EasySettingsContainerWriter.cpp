@@ -0,0 +1,177 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsContainerWriter.h"
+
+#include "Async/Async.h"
+#include "EasySettings.h"
+#include "EasySettingsStats.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Libs/DataSerializerLib.h"
+
+FEasySettingsContainerWriter::FEasySettingsContainerWriter(FOnWriteFinished InOnWriteFinished)
+	: OnWriteFinished(MoveTemp(InOnWriteFinished))
+	, bWorkerRunning(false)
+{
+}
+
+void FEasySettingsContainerWriter::EnqueueSnapshot(TArray<uint8>&& InBytes, const FString& InPath)
+{
+	EnqueueSnapshot(MoveTemp(InBytes), InPath, FString());
+}
+
+void FEasySettingsContainerWriter::EnqueueSnapshot(TArray<uint8>&& InBytes, const FString& InPath,
+                                                   const FString& InJournalPath)
+{
+	FScopeLock lock(&Mutex);
+
+	// Older snapshots of the same file are superseded by this one
+	Jobs.RemoveAll([&InPath](const FJob& InJob) { return InJob.Type == EJobType::Snapshot && InJob.Path == InPath; });
+
+	FJob& job = Jobs.AddDefaulted_GetRef();
+	job.Type = EJobType::Snapshot;
+	job.Bytes = MoveTemp(InBytes);
+	job.Path = InPath;
+	job.JournalPath = InJournalPath;
+	StartWorker();
+}
+
+void FEasySettingsContainerWriter::EnqueueAppend(TArray<uint8>&& InBytes, const FString& InPath)
+{
+	FScopeLock lock(&Mutex);
+
+	if (Jobs.Num() > 0 && Jobs.Last().Type == EJobType::Append && Jobs.Last().Path == InPath)
+	{
+		Jobs.Last().Bytes.Append(InBytes);
+	}
+	else
+	{
+		FJob& job = Jobs.AddDefaulted_GetRef();
+		job.Type = EJobType::Append;
+		job.Bytes = MoveTemp(InBytes);
+		job.Path = InPath;
+	}
+	StartWorker();
+}
+
+void FEasySettingsContainerWriter::StartWorker()
+{
+	// Called with the mutex held
+	if (bWorkerRunning)
+		return;
+
+	bWorkerRunning = true;
+	TSharedRef<FEasySettingsContainerWriter, ESPMode::ThreadSafe> self = AsShared();
+	WorkerTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [self]() { self->ProcessQueue(); });
+}
+
+void FEasySettingsContainerWriter::Flush()
+{
+	for (;;)
+	{
+		UE::Tasks::FTask task;
+		{
+			FScopeLock lock(&Mutex);
+			if (!bWorkerRunning)
+				return;
+			task = WorkerTask;
+		}
+		task.Wait();
+	}
+}
+
+bool FEasySettingsContainerWriter::HasPendingWork() const
+{
+	FScopeLock lock(&Mutex);
+	return bWorkerRunning;
+}
+
+bool FEasySettingsContainerWriter::WriteSnapshot(const TArray<uint8>& InBytes, const FString& InPath)
+{
+	IFileManager& fileManager = IFileManager::Get();
+	const FString tempPath = GetTempPath(InPath);
+	const FString backupPath = GetBackupPath(InPath);
+
+	// Leftover from an interrupted write
+	fileManager.Delete(*tempPath, false, true, true);
+
+	{
+		EASYSETTINGS_PHASE_SCOPE(CompressWrite);
+		UDataSerializerLib::WriteBytesToDiskCompressed(InBytes, tempPath);
+	}
+	if (!fileManager.FileExists(*tempPath))
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Failed to write container snapshot '%s'"), *tempPath);
+		return false;
+	}
+
+	// Moving with replace deletes the target before renaming, which is not atomic. Keep the previous file as the
+	// backup instead, then rename the new one into place, so a crash never leaves no complete container behind
+	if (fileManager.FileExists(*InPath) && !fileManager.Move(*backupPath, *InPath, true, true))
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Failed to back up container '%s'"), *InPath);
+		fileManager.Delete(*tempPath, false, true, true);
+		return false;
+	}
+	if (!fileManager.Move(*InPath, *tempPath, false, true))
+	{
+		// The temporary file is complete, the next load recovers it
+		UE_LOG(LogEasySettings, Warning, TEXT("Failed to replace container '%s'"), *InPath);
+		return false;
+	}
+	return true;
+}
+
+bool FEasySettingsContainerWriter::AppendToFile(const TArray<uint8>& InBytes, const FString& InPath)
+{
+	EASYSETTINGS_PHASE_SCOPE(JournalWrite);
+	if (!FFileHelper::SaveArrayToFile(InBytes, *InPath, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Failed to append to journal '%s'"), *InPath);
+		return false;
+	}
+	return true;
+}
+
+void FEasySettingsContainerWriter::ProcessQueue()
+{
+	for (;;)
+	{
+		FJob job;
+		{
+			FScopeLock lock(&Mutex);
+			if (Jobs.Num() == 0)
+			{
+				bWorkerRunning = false;
+				return;
+			}
+			job = MoveTemp(Jobs[0]);
+			Jobs.RemoveAt(0);
+		}
+		if (job.Type == EJobType::Append)
+		{
+			NotifyFinished(AppendToFile(job.Bytes, job.Path));
+			continue;
+		}
+
+		const bool bSuccess = WriteSnapshot(job.Bytes, job.Path);
+		if (bSuccess && !job.JournalPath.IsEmpty())
+		{
+			// Every record in the journal is contained in the snapshot now
+			IFileManager::Get().Delete(*job.JournalPath, false, true, true);
+		}
+		NotifyFinished(bSuccess);
+	}
+}
+
+void FEasySettingsContainerWriter::NotifyFinished(bool bSuccess) const
+{
+	if (!OnWriteFinished)
+		return;
+
+	AsyncTask(ENamedThreads::GameThread, [callback = OnWriteFinished, bSuccess]()
+	{
+		callback(bSuccess);
+	});
+}
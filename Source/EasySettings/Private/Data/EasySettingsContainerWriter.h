@@ -0,0 +1,123 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * @brief Persists container snapshots and journal records on a background task.
+ *
+ * Snapshots are serialized on the game thread and handed over as raw bytes. A single worker task compresses and writes
+ * them to a temporary file, then swaps it in while keeping the previous file as a backup, so a complete container is
+ * on disk at every point of the swap (see `FEasySettingsContainerLoader::Load` for the recovery). Snapshots queued for
+ * the same path while the worker is busy are coalesced, so only the newest one hits the disk.
+ *
+ * Journal records are appended to their file in the order they were queued. A snapshot can reset a journal once it has
+ * been written, since it contains every change recorded before it.
+ */
+class FEasySettingsContainerWriter : public TSharedFromThis<FEasySettingsContainerWriter, ESPMode::ThreadSafe>
+{
+public:
+	/** Called on the game thread after each write or append attempt. */
+	typedef TFunction<void(bool /*bSuccess*/)> FOnWriteFinished;
+
+	explicit FEasySettingsContainerWriter(FOnWriteFinished InOnWriteFinished);
+
+	/**
+	 * @brief Queues a snapshot to be written to the given path.
+	 *
+	 * Replaces any snapshot that is still waiting to be written to the same path.
+	 *
+	 * @param InBytes Serialized (uncompressed) container bytes.
+	 * @param InPath Target file path.
+	 */
+	void EnqueueSnapshot(TArray<uint8>&& InBytes, const FString& InPath);
+
+	/**
+	 * @brief Queues a snapshot and deletes the given journal once the snapshot has replaced the target file.
+	 *
+	 * @param InBytes Serialized (uncompressed) container bytes.
+	 * @param InPath Target file path.
+	 * @param InJournalPath Journal file made obsolete by this snapshot.
+	 */
+	void EnqueueSnapshot(TArray<uint8>&& InBytes, const FString& InPath, const FString& InJournalPath);
+
+	/**
+	 * @brief Queues bytes to be appended to a journal file.
+	 *
+	 * Consecutive appends to the same file are merged into a single write.
+	 *
+	 * @param InBytes Journal records.
+	 * @param InPath Journal file path.
+	 */
+	void EnqueueAppend(TArray<uint8>&& InBytes, const FString& InPath);
+
+	/**
+	 * @brief Blocks until every queued snapshot has been written.
+	 */
+	void Flush();
+
+	/**
+	 * @brief Checks whether there is queued or in-flight work.
+	 */
+	bool HasPendingWork() const;
+
+	/**
+	 * @brief Compresses and writes bytes to a temporary file, then swaps it in place of the target path.
+	 *
+	 * The previous target is renamed to its backup path before the temporary file is renamed to the target, so an
+	 * interruption at any step leaves either the target, the temporary file or the backup complete on disk.
+	 * Safe to call from any thread.
+	 *
+	 * @param InBytes Serialized (uncompressed) container bytes.
+	 * @param InPath Target file path.
+	 * @return true if the target file was replaced.
+	 */
+	static bool WriteSnapshot(const TArray<uint8>& InBytes, const FString& InPath);
+
+	/**
+	 * @brief Appends bytes to the end of a file, creating it if needed.
+	 *
+	 * Safe to call from any thread.
+	 *
+	 * @param InBytes Bytes to append.
+	 * @param InPath Target file path.
+	 * @return true if the bytes were written.
+	 */
+	static bool AppendToFile(const TArray<uint8>& InBytes, const FString& InPath);
+
+	/** Path a snapshot of the given file is written to before it is swapped in. */
+	static FString GetTempPath(const FString& InPath) { return InPath + TEXT(".tmp"); }
+
+	/** Path the previous version of the given file is kept at. */
+	static FString GetBackupPath(const FString& InPath) { return InPath + TEXT(".bak"); }
+
+private:
+	enum class EJobType : uint8
+	{
+		Snapshot,
+		Append
+	};
+
+	struct FJob
+	{
+		EJobType Type = EJobType::Snapshot;
+		TArray<uint8> Bytes;
+		FString Path;
+
+		/** Journal to delete after a successful snapshot. */
+		FString JournalPath;
+	};
+
+	void StartWorker();
+	void ProcessQueue();
+	void NotifyFinished(bool bSuccess) const;
+
+	FOnWriteFinished OnWriteFinished;
+
+	mutable FCriticalSection Mutex;
+	TArray<FJob> Jobs;
+	bool bWorkerRunning;
+	UE::Tasks::FTask WorkerTask;
+};
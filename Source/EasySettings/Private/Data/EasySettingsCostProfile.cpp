@@ -0,0 +1,101 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsCostProfile.h"
+
+#include "Dom/JsonObject.h"
+#include "EasySettings.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace EasySettingsCostProfilePrivate
+{
+	FString GetGroupName(ESettingsType InSettingsType)
+	{
+		return StaticEnum<ESettingsType>()->GetNameStringByValue(static_cast<int64>(InSettingsType));
+	}
+
+	bool SaveFile(const FString& InContents, const FString& InPath)
+	{
+		if (!FFileHelper::SaveStringToFile(InContents, *InPath))
+		{
+			UE_LOG(LogEasySettings, Warning, TEXT("Failed to write cost profile '%s'"), *InPath);
+			return false;
+		}
+		return true;
+	}
+}
+
+bool FEasySettingsCostSample::WriteCsv(const TArray<FEasySettingsCostSample>& InSamples, const FString& InPath)
+{
+	FString csv = TEXT("Group,Quality,Frames,FrameMs,MaxFrameMs,GameThreadMs,RenderThreadMs,GPUMs,BottleneckMs\n");
+	for (const FEasySettingsCostSample& sample : InSamples)
+	{
+		csv += FString::Printf(TEXT("%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+		                       *EasySettingsCostProfilePrivate::GetGroupName(sample.SettingsType), sample.Quality,
+		                       sample.Frames, sample.FrameTimeMs, sample.MaxFrameTimeMs, sample.GameThreadMs,
+		                       sample.RenderThreadMs, sample.GPUMs, sample.BottleneckMs);
+	}
+	return EasySettingsCostProfilePrivate::SaveFile(csv, InPath);
+}
+
+bool FEasySettingsCostSample::WriteJson(const TArray<FEasySettingsCostSample>& InSamples, const FString& InPath)
+{
+	TSharedRef<FJsonObject> root = MakeShared<FJsonObject>();
+	for (const FEasySettingsCostSample& sample : InSamples)
+	{
+		const FString group = EasySettingsCostProfilePrivate::GetGroupName(sample.SettingsType);
+		if (!root->HasField(group))
+		{
+			root->SetArrayField(group, TArray<TSharedPtr<FJsonValue>>());
+		}
+
+		TSharedRef<FJsonObject> level = MakeShared<FJsonObject>();
+		level->SetNumberField(TEXT("Quality"), sample.Quality);
+		level->SetNumberField(TEXT("Frames"), sample.Frames);
+		level->SetNumberField(TEXT("FrameMs"), sample.FrameTimeMs);
+		level->SetNumberField(TEXT("MaxFrameMs"), sample.MaxFrameTimeMs);
+		level->SetNumberField(TEXT("GameThreadMs"), sample.GameThreadMs);
+		level->SetNumberField(TEXT("RenderThreadMs"), sample.RenderThreadMs);
+		level->SetNumberField(TEXT("GPUMs"), sample.GPUMs);
+		level->SetNumberField(TEXT("BottleneckMs"), sample.BottleneckMs);
+
+		TArray<TSharedPtr<FJsonValue>> levels = root->GetArrayField(group);
+		levels.Add(MakeShared<FJsonValueObject>(level));
+		root->SetArrayField(group, levels);
+	}
+
+	FString json;
+	TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&json);
+	if (!FJsonSerializer::Serialize(root, writer))
+		return false;
+	return EasySettingsCostProfilePrivate::SaveFile(json, InPath);
+}
+
+TArray<ESettingsType> FEasySettingsCostSample::SortGroupsByCost(const TArray<FEasySettingsCostSample>& InSamples)
+{
+	TMap<ESettingsType, TPair<float, float>> ranges;
+	for (const FEasySettingsCostSample& sample : InSamples)
+	{
+		if (TPair<float, float>* range = ranges.Find(sample.SettingsType))
+		{
+			range->Key = FMath::Min(range->Key, sample.BottleneckMs);
+			range->Value = FMath::Max(range->Value, sample.BottleneckMs);
+		}
+		else
+		{
+			ranges.Add(sample.SettingsType, TPair<float, float>(sample.BottleneckMs, sample.BottleneckMs));
+		}
+	}
+
+	TArray<ESettingsType> groups;
+	ranges.GetKeys(groups);
+	groups.Sort([&ranges](ESettingsType A, ESettingsType B)
+	{
+		const TPair<float, float>& rangeA = ranges[A];
+		const TPair<float, float>& rangeB = ranges[B];
+		return rangeA.Value - rangeA.Key > rangeB.Value - rangeB.Key;
+	});
+	return groups;
+}
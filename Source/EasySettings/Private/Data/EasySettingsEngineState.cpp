@@ -0,0 +1,300 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsEngineState.h"
+
+FEasySettingsEngineState FEasySettingsEngineState::Capture(const UGameUserSettings* InSettings)
+{
+	check(IsValid(InSettings));
+	FEasySettingsEngineState state;
+	state.AntiAliasingQuality = InSettings->GetAntiAliasingQuality();
+	state.TextureQuality = InSettings->GetTextureQuality();
+	state.VisualEffectQuality = InSettings->GetVisualEffectQuality();
+	state.PostProcessingQuality = InSettings->GetPostProcessingQuality();
+	state.ShadingQuality = InSettings->GetShadingQuality();
+	state.FoliageQuality = InSettings->GetFoliageQuality();
+	state.ReflectionQuality = InSettings->GetReflectionQuality();
+	state.GlobalIlluminationQuality = InSettings->GetGlobalIlluminationQuality();
+	state.ViewDistanceQuality = InSettings->GetViewDistanceQuality();
+	state.ShadowQuality = InSettings->GetShadowQuality();
+	state.AudioQualityLevel = InSettings->GetAudioQualityLevel();
+	state.bVSyncEnabled = InSettings->IsVSyncEnabled();
+	state.FrameRateLimit = InSettings->GetFrameRateLimit();
+	state.FullscreenMode = InSettings->GetFullscreenMode();
+	state.ScreenResolution = InSettings->GetScreenResolution();
+	state.CaptureDisplay(InSettings);
+	return state;
+}
+
+void FEasySettingsEngineState::CaptureDisplay(const UGameUserSettings* InSettings)
+{
+	check(IsValid(InSettings));
+	ResolutionScale = InSettings->GetResolutionScaleNormalized();
+	bDynamicResolutionEnabled = InSettings->IsDynamicResolutionEnabled();
+	bHDREnabled = InSettings->IsHDREnabled();
+	HDRDisplayNits = InSettings->GetCurrentHDRDisplayNits();
+}
+
+void FEasySettingsEngineState::Restore(UGameUserSettings* InSettings) const
+{
+	check(IsValid(InSettings));
+	InSettings->SetAntiAliasingQuality(AntiAliasingQuality);
+	InSettings->SetTextureQuality(TextureQuality);
+	InSettings->SetVisualEffectQuality(VisualEffectQuality);
+	InSettings->SetPostProcessingQuality(PostProcessingQuality);
+	InSettings->SetShadingQuality(ShadingQuality);
+	InSettings->SetFoliageQuality(FoliageQuality);
+	InSettings->SetReflectionQuality(ReflectionQuality);
+	InSettings->SetGlobalIlluminationQuality(GlobalIlluminationQuality);
+	InSettings->SetViewDistanceQuality(ViewDistanceQuality);
+	InSettings->SetShadowQuality(ShadowQuality);
+	InSettings->SetAudioQualityLevel(AudioQualityLevel);
+	InSettings->SetVSyncEnabled(bVSyncEnabled);
+	InSettings->SetFrameRateLimit(FrameRateLimit);
+	InSettings->SetFullscreenMode(FullscreenMode);
+	InSettings->SetScreenResolution(ScreenResolution);
+	InSettings->SetResolutionScaleNormalized(ResolutionScale);
+	InSettings->SetDynamicResolutionEnabled(bDynamicResolutionEnabled);
+	if (bHDREnabled != InSettings->IsHDREnabled() || HDRDisplayNits != InSettings->GetCurrentHDRDisplayNits())
+	{
+		InSettings->EnableHDRDisplayOutput(bHDREnabled, HDRDisplayNits);
+	}
+}
+
+int32 FEasySettingsEngineState::RestoreChanged(UGameUserSettings* InSettings,
+                                              const FEasySettingsEngineState& InCurrent) const
+{
+	check(IsValid(InSettings));
+	int32 changed = 0;
+	if (AntiAliasingQuality != InCurrent.AntiAliasingQuality)
+	{
+		InSettings->SetAntiAliasingQuality(AntiAliasingQuality);
+		++changed;
+	}
+	if (TextureQuality != InCurrent.TextureQuality)
+	{
+		InSettings->SetTextureQuality(TextureQuality);
+		++changed;
+	}
+	if (VisualEffectQuality != InCurrent.VisualEffectQuality)
+	{
+		InSettings->SetVisualEffectQuality(VisualEffectQuality);
+		++changed;
+	}
+	if (PostProcessingQuality != InCurrent.PostProcessingQuality)
+	{
+		InSettings->SetPostProcessingQuality(PostProcessingQuality);
+		++changed;
+	}
+	if (ShadingQuality != InCurrent.ShadingQuality)
+	{
+		InSettings->SetShadingQuality(ShadingQuality);
+		++changed;
+	}
+	if (FoliageQuality != InCurrent.FoliageQuality)
+	{
+		InSettings->SetFoliageQuality(FoliageQuality);
+		++changed;
+	}
+	if (ReflectionQuality != InCurrent.ReflectionQuality)
+	{
+		InSettings->SetReflectionQuality(ReflectionQuality);
+		++changed;
+	}
+	if (GlobalIlluminationQuality != InCurrent.GlobalIlluminationQuality)
+	{
+		InSettings->SetGlobalIlluminationQuality(GlobalIlluminationQuality);
+		++changed;
+	}
+	if (ViewDistanceQuality != InCurrent.ViewDistanceQuality)
+	{
+		InSettings->SetViewDistanceQuality(ViewDistanceQuality);
+		++changed;
+	}
+	if (ShadowQuality != InCurrent.ShadowQuality)
+	{
+		InSettings->SetShadowQuality(ShadowQuality);
+		++changed;
+	}
+	if (AudioQualityLevel != InCurrent.AudioQualityLevel)
+	{
+		InSettings->SetAudioQualityLevel(AudioQualityLevel);
+		++changed;
+	}
+	if (bVSyncEnabled != InCurrent.bVSyncEnabled)
+	{
+		InSettings->SetVSyncEnabled(bVSyncEnabled);
+		++changed;
+	}
+	if (FrameRateLimit != InCurrent.FrameRateLimit)
+	{
+		InSettings->SetFrameRateLimit(FrameRateLimit);
+		++changed;
+	}
+	if (FullscreenMode != InCurrent.FullscreenMode)
+	{
+		InSettings->SetFullscreenMode(FullscreenMode);
+		++changed;
+	}
+	if (ScreenResolution != InCurrent.ScreenResolution)
+	{
+		InSettings->SetScreenResolution(ScreenResolution);
+		++changed;
+	}
+	if (ResolutionScale != InCurrent.ResolutionScale)
+	{
+		InSettings->SetResolutionScaleNormalized(ResolutionScale);
+		++changed;
+	}
+	if (bDynamicResolutionEnabled != InCurrent.bDynamicResolutionEnabled)
+	{
+		InSettings->SetDynamicResolutionEnabled(bDynamicResolutionEnabled);
+		++changed;
+	}
+	if (bHDREnabled != InCurrent.bHDREnabled || HDRDisplayNits != InCurrent.HDRDisplayNits)
+	{
+		InSettings->EnableHDRDisplayOutput(bHDREnabled, HDRDisplayNits);
+		++changed;
+	}
+	return changed;
+}
+
+FArchive& operator<<(FArchive& Ar, FEasySettingsEngineState& State)
+{
+	Ar << State.AntiAliasingQuality;
+	Ar << State.TextureQuality;
+	Ar << State.VisualEffectQuality;
+	Ar << State.PostProcessingQuality;
+	Ar << State.ShadingQuality;
+	Ar << State.FoliageQuality;
+	Ar << State.ReflectionQuality;
+	Ar << State.GlobalIlluminationQuality;
+	Ar << State.ViewDistanceQuality;
+	Ar << State.ShadowQuality;
+	Ar << State.AudioQualityLevel;
+	Ar << State.bVSyncEnabled;
+	Ar << State.FrameRateLimit;
+	uint8 fullscreenMode = State.FullscreenMode;
+	Ar << fullscreenMode;
+	State.FullscreenMode = static_cast<EWindowMode::Type>(fullscreenMode);
+	Ar << State.ScreenResolution;
+	return Ar;
+}
+
+void FEasySettingsEngineState::SerializeDisplay(FArchive& Ar)
+{
+	Ar << ResolutionScale;
+	Ar << bDynamicResolutionEnabled;
+	Ar << bHDREnabled;
+	Ar << HDRDisplayNits;
+}
+
+int32 FEasySettingsEngineState::GetGroupQuality(ESettingsType InSettingsType) const
+{
+	switch (InSettingsType)
+	{
+	case ESettingsType::TYPE_AA: return AntiAliasingQuality;
+	case ESettingsType::TYPE_Textures: return TextureQuality;
+	case ESettingsType::TYPE_Effects: return FMath::Min3(VisualEffectQuality, PostProcessingQuality, ShadingQuality);
+	case ESettingsType::TYPE_Details:
+		return FMath::Min(FMath::Min3(FoliageQuality, ReflectionQuality, AudioQualityLevel),
+		                  FMath::Min(GlobalIlluminationQuality, ViewDistanceQuality));
+	case ESettingsType::TYPE_Shadows: return ShadowQuality;
+	default: return 0;
+	}
+}
+
+void FEasySettingsEngineState::RestoreGroup(ESettingsType InSettingsType, UGameUserSettings* InSettings) const
+{
+	check(IsValid(InSettings));
+	switch (InSettingsType)
+	{
+	case ESettingsType::TYPE_AA:
+		InSettings->SetAntiAliasingQuality(AntiAliasingQuality);
+		break;
+	case ESettingsType::TYPE_Textures:
+		InSettings->SetTextureQuality(TextureQuality);
+		break;
+	case ESettingsType::TYPE_Effects:
+		InSettings->SetVisualEffectQuality(VisualEffectQuality);
+		InSettings->SetPostProcessingQuality(PostProcessingQuality);
+		InSettings->SetShadingQuality(ShadingQuality);
+		break;
+	case ESettingsType::TYPE_Details:
+		InSettings->SetFoliageQuality(FoliageQuality);
+		InSettings->SetReflectionQuality(ReflectionQuality);
+		InSettings->SetAudioQualityLevel(AudioQualityLevel);
+		InSettings->SetGlobalIlluminationQuality(GlobalIlluminationQuality);
+		InSettings->SetViewDistanceQuality(ViewDistanceQuality);
+		break;
+	case ESettingsType::TYPE_Shadows:
+		InSettings->SetShadowQuality(ShadowQuality);
+		break;
+	default: ;
+	}
+}
+
+EEasySettingsEngineChange FEasySettingsEngineState::Diff(const FEasySettingsEngineState& Other) const
+{
+	EEasySettingsEngineChange changes = EEasySettingsEngineChange::None;
+	if (FullscreenMode != Other.FullscreenMode || ScreenResolution != Other.ScreenResolution)
+	{
+		changes |= EEasySettingsEngineChange::Window;
+	}
+	if (AntiAliasingQuality != Other.AntiAliasingQuality
+		|| TextureQuality != Other.TextureQuality
+		|| VisualEffectQuality != Other.VisualEffectQuality
+		|| PostProcessingQuality != Other.PostProcessingQuality
+		|| ShadingQuality != Other.ShadingQuality
+		|| FoliageQuality != Other.FoliageQuality
+		|| ReflectionQuality != Other.ReflectionQuality
+		|| GlobalIlluminationQuality != Other.GlobalIlluminationQuality
+		|| ViewDistanceQuality != Other.ViewDistanceQuality
+		|| ShadowQuality != Other.ShadowQuality)
+	{
+		changes |= EEasySettingsEngineChange::Scalability;
+	}
+	if (bVSyncEnabled != Other.bVSyncEnabled)
+	{
+		changes |= EEasySettingsEngineChange::VSync;
+	}
+	if (FrameRateLimit != Other.FrameRateLimit)
+	{
+		changes |= EEasySettingsEngineChange::FrameRate;
+	}
+	if (AudioQualityLevel != Other.AudioQualityLevel)
+	{
+		changes |= EEasySettingsEngineChange::Audio;
+	}
+	if (ResolutionScale != Other.ResolutionScale
+		|| bDynamicResolutionEnabled != Other.bDynamicResolutionEnabled
+		|| bHDREnabled != Other.bHDREnabled
+		|| HDRDisplayNits != Other.HDRDisplayNits)
+	{
+		changes |= EEasySettingsEngineChange::Display;
+	}
+	return changes;
+}
+
+bool FEasySettingsEngineState::operator==(const FEasySettingsEngineState& Other) const
+{
+	return AntiAliasingQuality == Other.AntiAliasingQuality
+		&& TextureQuality == Other.TextureQuality
+		&& VisualEffectQuality == Other.VisualEffectQuality
+		&& PostProcessingQuality == Other.PostProcessingQuality
+		&& ShadingQuality == Other.ShadingQuality
+		&& FoliageQuality == Other.FoliageQuality
+		&& ReflectionQuality == Other.ReflectionQuality
+		&& GlobalIlluminationQuality == Other.GlobalIlluminationQuality
+		&& ViewDistanceQuality == Other.ViewDistanceQuality
+		&& ShadowQuality == Other.ShadowQuality
+		&& AudioQualityLevel == Other.AudioQualityLevel
+		&& bVSyncEnabled == Other.bVSyncEnabled
+		&& FrameRateLimit == Other.FrameRateLimit
+		&& FullscreenMode == Other.FullscreenMode
+		&& ScreenResolution == Other.ScreenResolution
+		&& ResolutionScale == Other.ResolutionScale
+		&& bDynamicResolutionEnabled == Other.bDynamicResolutionEnabled
+		&& bHDREnabled == Other.bHDREnabled
+		&& HDRDisplayNits == Other.HDRDisplayNits;
+}
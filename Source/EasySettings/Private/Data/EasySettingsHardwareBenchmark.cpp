@@ -0,0 +1,142 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsHardwareBenchmark.h"
+
+#include "EasySettings.h"
+#include "GameFramework/GameUserSettings.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Libs/EasySettingsLib.h"
+#include "Misc/App.h"
+#include "Misc/ConfigCacheIni.h"
+#include "RHI.h"
+#include "Scalability.h"
+
+namespace EasySettingsHardwareBenchmarkPrivate
+{
+	const TCHAR* ConfigSection = TEXT("EasySettings.HardwareBenchmark");
+
+	/** Largest supported fullscreen resolution that fits the desktop and the given height, 0 meaning the desktop. */
+	FIntPoint PickResolution(int32 InMaxHeight)
+	{
+		const FIntPoint desktop = GEngine->GameUserSettings->GetDesktopResolution();
+		if (InMaxHeight <= 0 || desktop.Y <= InMaxHeight)
+		{
+			return desktop;
+		}
+
+		TArray<FIntPoint> resolutions;
+		UKismetSystemLibrary::GetSupportedFullscreenResolutions(resolutions);
+		FIntPoint best = FIntPoint::ZeroValue;
+		for (const FIntPoint& resolution : resolutions)
+		{
+			if (resolution.Y > InMaxHeight || resolution.X > desktop.X)
+				continue;
+			if (resolution.X * resolution.Y > best.X * best.Y)
+			{
+				best = resolution;
+			}
+		}
+		return best == FIntPoint::ZeroValue ? desktop : best;
+	}
+}
+
+bool FEasySettingsHardwareBenchmark::Run(int32 InWorkScale, FEasySettingsHardwareBenchmark& OutResult)
+{
+	if (!FApp::CanEverRender() || !GEngine || !GEngine->GameUserSettings)
+	{
+		return false;
+	}
+
+	const double start = FPlatformTime::Seconds();
+	const Scalability::FQualityLevels levels = Scalability::BenchmarkQualityLevels(FMath::Max(InWorkScale, 1));
+
+	OutResult = FEasySettingsHardwareBenchmark();
+	OutResult.CPUScore = levels.CPUBenchmarkResults;
+	OutResult.GPUScore = levels.GPUBenchmarkResults;
+	OutResult.AntiAliasingQuality = levels.AntiAliasingQuality;
+	OutResult.TextureQuality = levels.TextureQuality;
+	// Same groups the subsystem setters drive together
+	OutResult.EffectsQuality = FMath::Min3(levels.EffectsQuality, levels.PostProcessQuality, levels.ShadingQuality);
+	OutResult.DetailsQuality = FMath::Min(
+		FMath::Min(levels.FoliageQuality, levels.ReflectionQuality),
+		FMath::Min(levels.GlobalIlluminationQuality, levels.ViewDistanceQuality));
+	OutResult.ShadowsQuality = levels.ShadowQuality;
+
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	const int32 overall = OutResult.GetOverallQuality();
+	if (developerSettings->AutoDetectMaxResolutionHeights.IsValidIndex(overall))
+	{
+		OutResult.Resolution = EasySettingsHardwareBenchmarkPrivate::PickResolution(
+			developerSettings->AutoDetectMaxResolutionHeights[overall]);
+	}
+	if (developerSettings->AutoDetectFrameRateLimits.IsValidIndex(overall))
+	{
+		OutResult.FrameRateLimit = developerSettings->AutoDetectFrameRateLimits[overall];
+	}
+
+	UE_LOG(LogEasySettings, Log, TEXT("Hardware benchmark: CPU %.1f, GPU %.1f, overall quality %d (%.2f s)"),
+	       OutResult.CPUScore, OutResult.GPUScore, overall, FPlatformTime::Seconds() - start);
+	return true;
+}
+
+FString FEasySettingsHardwareBenchmark::ComputeFingerprint()
+{
+	const FString hardware = FString::Printf(TEXT("%s|%s|%s|%d|%u"),
+	                                         *FPlatformMisc::GetCPUBrand(),
+	                                         *GRHIAdapterName,
+	                                         *GRHIAdapterUserDriverVersion,
+	                                         FPlatformMisc::NumberOfCoresIncludingHyperthreads(),
+	                                         FPlatformMemory::GetConstants().TotalPhysicalGB);
+	return FString::Printf(TEXT("%08X"), FCrc::StrCrc32(*hardware));
+}
+
+bool FEasySettingsHardwareBenchmark::LoadCached(FString& OutFingerprint, FEasySettingsHardwareBenchmark& OutResult)
+{
+	using namespace EasySettingsHardwareBenchmarkPrivate;
+	if (!GConfig || !GConfig->GetString(ConfigSection, TEXT("Fingerprint"), OutFingerprint, GGameUserSettingsIni))
+	{
+		return false;
+	}
+
+	OutResult = FEasySettingsHardwareBenchmark();
+	GConfig->GetFloat(ConfigSection, TEXT("CPUScore"), OutResult.CPUScore, GGameUserSettingsIni);
+	GConfig->GetFloat(ConfigSection, TEXT("GPUScore"), OutResult.GPUScore, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("AntiAliasingQuality"), OutResult.AntiAliasingQuality, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("TextureQuality"), OutResult.TextureQuality, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("EffectsQuality"), OutResult.EffectsQuality, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("DetailsQuality"), OutResult.DetailsQuality, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("ShadowsQuality"), OutResult.ShadowsQuality, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("ResolutionX"), OutResult.Resolution.X, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("ResolutionY"), OutResult.Resolution.Y, GGameUserSettingsIni);
+	GConfig->GetInt(ConfigSection, TEXT("FrameRateLimit"), OutResult.FrameRateLimit, GGameUserSettingsIni);
+	return true;
+}
+
+void FEasySettingsHardwareBenchmark::SaveCached(const FString& InFingerprint) const
+{
+	using namespace EasySettingsHardwareBenchmarkPrivate;
+	if (!GConfig)
+	{
+		return;
+	}
+
+	GConfig->SetString(ConfigSection, TEXT("Fingerprint"), *InFingerprint, GGameUserSettingsIni);
+	GConfig->SetFloat(ConfigSection, TEXT("CPUScore"), CPUScore, GGameUserSettingsIni);
+	GConfig->SetFloat(ConfigSection, TEXT("GPUScore"), GPUScore, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("AntiAliasingQuality"), AntiAliasingQuality, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("TextureQuality"), TextureQuality, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("EffectsQuality"), EffectsQuality, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("DetailsQuality"), DetailsQuality, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("ShadowsQuality"), ShadowsQuality, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("ResolutionX"), Resolution.X, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("ResolutionY"), Resolution.Y, GGameUserSettingsIni);
+	GConfig->SetInt(ConfigSection, TEXT("FrameRateLimit"), FrameRateLimit, GGameUserSettingsIni);
+	GConfig->Flush(false, GGameUserSettingsIni);
+}
+
+int32 FEasySettingsHardwareBenchmark::GetOverallQuality() const
+{
+	return FMath::Min(FMath::Min3(AntiAliasingQuality, TextureQuality, EffectsQuality),
+	                  FMath::Min(DetailsQuality, ShadowsQuality));
+}
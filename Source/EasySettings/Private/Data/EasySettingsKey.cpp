@@ -0,0 +1,45 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsKey.h"
+
+#include "EasySettings.h"
+
+FEasySettingsKeyRegistry& FEasySettingsKeyRegistry::Get()
+{
+	static FEasySettingsKeyRegistry registry;
+	return registry;
+}
+
+int32 FEasySettingsKeyRegistry::Resolve(uint64 InHash, const TCHAR* InName)
+{
+	if (!InName || !*InName)
+		return INDEX_NONE;
+
+	FScopeLock lock(&Mutex);
+	if (const int32* slot = SlotByHash.Find(InHash))
+	{
+		if (!ensureMsgf(Names[*slot].Equals(InName, ESearchCase::CaseSensitive),
+		                TEXT("Setting key '%s' collides with '%s'"), InName, *Names[*slot]))
+		{
+			return INDEX_NONE;
+		}
+		return *slot;
+	}
+
+	const int32 slot = Names.Add(InName);
+	SlotByHash.Add(InHash, slot);
+	return slot;
+}
+
+int32 FEasySettingsKeyRegistry::Num() const
+{
+	FScopeLock lock(&Mutex);
+	return Names.Num();
+}
+
+FString FEasySettingsKeyRegistry::GetName(int32 InSlot) const
+{
+	FScopeLock lock(&Mutex);
+	return Names.IsValidIndex(InSlot) ? Names[InSlot] : FString();
+}
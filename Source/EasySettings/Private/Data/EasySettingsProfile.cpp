@@ -0,0 +1,121 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsProfile.h"
+
+#include "Data/EasySettingsSetter.h"
+#include "Engine/Engine.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace EasySettingsProfilePrivate
+{
+	/** Magic number at the start of every profile file ("ESPR"). */
+	constexpr uint32 PROFILE_MAGIC = 0x52505345;
+	constexpr uint16 PROFILE_VERSION_INITIAL = 1;
+
+	/** Adds the typed and named container values. */
+	constexpr uint16 PROFILE_VERSION_TYPED = 2;
+
+	/** Adds the display settings of the engine state. */
+	constexpr uint16 PROFILE_VERSION_DISPLAY = 3;
+
+	constexpr uint16 PROFILE_VERSION = PROFILE_VERSION_DISPLAY;
+}
+
+void FEasySettingsProfile::Write(FMemoryWriter& MemoryWriter) const
+{
+	uint32 magic = EasySettingsProfilePrivate::PROFILE_MAGIC;
+	uint16 version = EasySettingsProfilePrivate::PROFILE_VERSION;
+	FString name = Name.ToString();
+	FEasySettingsEngineState engineState = EngineState;
+	int32 count = ContainerValues.Num();
+	TMap<uint8, int32> ints = ContainerInts;
+	TMap<uint8, bool> bools = ContainerBools;
+	TMap<uint8, FVector4> vectors = ContainerVectors;
+	TMap<FString, float> namedValues = NamedValues;
+
+	MemoryWriter << magic;
+	MemoryWriter << version;
+	MemoryWriter << name;
+	MemoryWriter << engineState;
+	MemoryWriter << count;
+	MemoryWriter.Serialize(const_cast<float*>(ContainerValues.GetData()), count * sizeof(float));
+	MemoryWriter << ints;
+	MemoryWriter << bools;
+	MemoryWriter << vectors;
+	MemoryWriter << namedValues;
+	engineState.SerializeDisplay(MemoryWriter);
+}
+
+bool FEasySettingsProfile::Read(FMemoryReader& MemoryReader)
+{
+	uint32 magic = 0;
+	uint16 version = 0;
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < static_cast<int64>(sizeof(magic) + sizeof(version)))
+	{
+		return false;
+	}
+	MemoryReader << magic;
+	MemoryReader << version;
+	if (magic != EasySettingsProfilePrivate::PROFILE_MAGIC || version > EasySettingsProfilePrivate::PROFILE_VERSION)
+	{
+		return false;
+	}
+
+	FString name;
+	FEasySettingsEngineState engineState;
+	int32 count = 0;
+	MemoryReader << name;
+	MemoryReader << engineState;
+	MemoryReader << count;
+	if (MemoryReader.IsError() || count < 0 || count > EasySettings::VALUES_NUM
+		|| MemoryReader.TotalSize() - MemoryReader.Tell() < count * static_cast<int64>(sizeof(float)))
+	{
+		return false;
+	}
+
+	TArray<float> containerValues;
+	containerValues.SetNumUninitialized(count);
+	MemoryReader.Serialize(containerValues.GetData(), count * sizeof(float));
+
+	// Profiles of the first version only hold the float values
+	TMap<uint8, int32> ints;
+	TMap<uint8, bool> bools;
+	TMap<uint8, FVector4> vectors;
+	TMap<FString, float> namedValues;
+	if (version >= EasySettingsProfilePrivate::PROFILE_VERSION_TYPED)
+	{
+		MemoryReader << ints;
+		MemoryReader << bools;
+		MemoryReader << vectors;
+		MemoryReader << namedValues;
+		if (MemoryReader.IsError())
+		{
+			return false;
+		}
+	}
+
+	if (version >= EasySettingsProfilePrivate::PROFILE_VERSION_DISPLAY)
+	{
+		engineState.SerializeDisplay(MemoryReader);
+		if (MemoryReader.IsError())
+		{
+			return false;
+		}
+	}
+	else if (GEngine && GEngine->GetGameUserSettings())
+	{
+		// Older profiles did not capture the display settings, applying them keeps the current ones
+		engineState.CaptureDisplay(GEngine->GetGameUserSettings());
+	}
+
+	Name = FName(*name);
+	EngineState = engineState;
+	ContainerValues = MoveTemp(containerValues);
+	ContainerInts = MoveTemp(ints);
+	ContainerBools = MoveTemp(bools);
+	ContainerVectors = MoveTemp(vectors);
+	NamedValues = MoveTemp(namedValues);
+	return true;
+}
@@ -0,0 +1,145 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsSchema.h"
+
+#include "EasySettings.h"
+
+FEasySettingsSchema::FEasySettingsSchema()
+	: Layout(EasySettings::FTypedLayout::GetEmpty())
+{
+	Build(TArray<FEasySettingsValueSchemaEntry>());
+}
+
+void FEasySettingsSchema::Build(const TArray<FEasySettingsValueSchemaEntry>& InEntries)
+{
+	// Categories without an entry accept any finite value
+	for (int32 i = 0; i < EasySettings::VALUES_CAPACITY; ++i)
+	{
+		Mins[i] = -MAX_flt;
+		Maxs[i] = MAX_flt;
+		Defaults[i] = 0.0f;
+		Steps[i] = 0.0f;
+	}
+	Keys.Reset();
+	SteppedKeys.Reset();
+
+	// The last entry of a key decides its type
+	EEasySettingsValueType types[EasySettings::VALUES_CAPACITY];
+	for (EEasySettingsValueType& type : types)
+	{
+		type = EEasySettingsValueType::Float;
+	}
+	for (const FEasySettingsValueSchemaEntry& entry : InEntries)
+	{
+		if (!EasySettings::FContainer::IsValidKey(entry.ContainerKey))
+		{
+			UE_LOG(LogEasySettings, Warning, TEXT("Schema entry for invalid key %d ignored"), entry.ContainerKey);
+			continue;
+		}
+		types[entry.ContainerKey] = entry.Type;
+	}
+
+	TArray<uint8> intKeys;
+	TArray<uint8> boolKeys;
+	TArray<uint8> vectorKeys;
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		switch (types[i])
+		{
+		case EEasySettingsValueType::Int: intKeys.Add(static_cast<uint8>(i)); break;
+		case EEasySettingsValueType::Bool: boolKeys.Add(static_cast<uint8>(i)); break;
+		case EEasySettingsValueType::Vector: vectorKeys.Add(static_cast<uint8>(i)); break;
+		default: break;
+		}
+	}
+	Layout = MakeShared<const EasySettings::FTypedLayout>(intKeys, boolKeys, vectorKeys);
+
+	for (const FEasySettingsValueSchemaEntry& entry : InEntries)
+	{
+		if (!EasySettings::FContainer::IsValidKey(entry.ContainerKey) || types[entry.ContainerKey] != EEasySettingsValueType::Float)
+		{
+			continue;
+		}
+		const uint8 key = entry.ContainerKey;
+		Mins[key] = FMath::Min(entry.Min, entry.Max);
+		Maxs[key] = FMath::Max(entry.Min, entry.Max);
+		Steps[key] = FMath::Max(entry.Step, 0.0f);
+		Defaults[key] = FMath::Clamp(entry.Default, Mins[key], Maxs[key]);
+		Keys.AddUnique(key);
+		if (Steps[key] > 0.0f)
+		{
+			SteppedKeys.AddUnique(key);
+		}
+		else
+		{
+			SteppedKeys.Remove(key);
+		}
+	}
+}
+
+float FEasySettingsSchema::Snap(uint8 InKey, float InValue) const
+{
+	const float step = Steps[InKey];
+	const float snapped = Mins[InKey] + FMath::RoundToFloat((InValue - Mins[InKey]) / step) * step;
+	return FMath::Min(snapped, Maxs[InKey]);
+}
+
+float FEasySettingsSchema::Sanitize(uint8 InKey, float InValue) const
+{
+	if (!EasySettings::FContainer::IsValidKey(InKey))
+		return InValue;
+
+	float value = FMath::IsFinite(InValue) ? InValue : Defaults[InKey];
+	value = FMath::Clamp(value, Mins[InKey], Maxs[InKey]);
+	return Steps[InKey] > 0.0f ? Snap(InKey, value) : value;
+}
+
+int32 FEasySettingsSchema::SanitizeAll(EasySettings::FContainer& InOutValues,
+                                       EasySettings::FKeyBits& OutRepairedKeys) const
+{
+	OutRepairedKeys = EasySettings::FKeyBits();
+	float* values = InOutValues.GetData();
+
+	int32 repaired = 0;
+	const VectorRegister4Float zero = VectorZeroFloat();
+	for (int32 i = 0; i < EasySettings::VALUES_CAPACITY; i += 4)
+	{
+		const VectorRegister4Float value = VectorLoadAligned(values + i);
+
+		// x - x is 0 for finite values and NaN for NaN and infinities
+		const VectorRegister4Float finiteMask = VectorCompareEQ(VectorSubtract(value, value), zero);
+		VectorRegister4Float sanitized = VectorSelect(finiteMask, value, VectorLoadAligned(Defaults + i));
+		sanitized = VectorMin(VectorMax(sanitized, VectorLoadAligned(Mins + i)), VectorLoadAligned(Maxs + i));
+
+		// Not-equal is also true for NaN lanes
+		const uint32 changedBits = VectorMaskBits(VectorCompareNE(sanitized, value));
+		if (changedBits == 0)
+			continue;
+
+		VectorStoreAligned(sanitized, values + i);
+		for (int32 lane = 0; lane < 4; ++lane)
+		{
+			const int32 key = i + lane;
+			if ((changedBits & (1u << lane)) && key < EasySettings::VALUES_NUM && InOutValues.Present[key])
+			{
+				OutRepairedKeys[key] = true;
+				++repaired;
+			}
+		}
+	}
+
+	for (uint8 key : SteppedKeys)
+	{
+		const float snapped = Snap(key, values[key]);
+		if (snapped == values[key])
+			continue;
+		values[key] = snapped;
+		if (InOutValues.Present[key] && !OutRepairedKeys[key])
+		{
+			OutRepairedKeys[key] = true;
+			++repaired;
+		}
+	}
+	return repaired;
+}
@@ -3,15 +3,48 @@
 
 #include "Data/EasySettingsSetter.h"
 
-void UEasySettingsSetter::InitializeEmpty()
+#include "Data/EasySettingsKey.h"
+#include "Data/EasySettingsSchema.h"
+#include "Data/EasySettingsSharedValues.h"
+#include "EasySettings.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+EasySettings::FTypedLayout::FTypedLayout(const TArray<uint8>& InIntKeys, const TArray<uint8>& InBoolKeys,
+                                         const TArray<uint8>& InVectorKeys)
+	: IntKeys(InIntKeys)
+	, BoolKeys(InBoolKeys)
+	, VectorKeys(InVectorKeys)
 {
-	Values.Empty();
-	int32 n = EasySettings::VALUES_NUM;
-	Values.Reserve(n);
-	for (uint8 i = 0; i < n; ++i)
+	FMemory::Memset(IntSlots, NO_SLOT);
+	FMemory::Memset(BoolSlots, NO_SLOT);
+	FMemory::Memset(VectorSlots, NO_SLOT);
+	for (int32 i = 0; i < IntKeys.Num(); ++i)
 	{
-		Values.Add(i, 0.0f);
+		IntSlots[IntKeys[i]] = static_cast<uint8>(i);
 	}
+	for (int32 i = 0; i < BoolKeys.Num(); ++i)
+	{
+		BoolSlots[BoolKeys[i]] = static_cast<uint8>(i);
+	}
+	for (int32 i = 0; i < VectorKeys.Num(); ++i)
+	{
+		VectorSlots[VectorKeys[i]] = static_cast<uint8>(i);
+	}
+}
+
+const TSharedRef<const EasySettings::FTypedLayout>& EasySettings::FTypedLayout::GetEmpty()
+{
+	static const TSharedRef<const FTypedLayout> layout = MakeShared<const FTypedLayout>(
+		TArray<uint8>(), TArray<uint8>(), TArray<uint8>());
+	return layout;
+}
+
+void UEasySettingsSetter::InitializeEmpty()
+{
+	Values.Reset();
+	NamedValues.Reset();
+	MarkPersisted();
 }
 
 void UEasySettingsSetter::SetValue_Implementation(uint8 InCategory, float InValue)
@@ -20,39 +53,1003 @@ void UEasySettingsSetter::SetValue_Implementation(uint8 InCategory, float InValu
 	{
 		return;
 	}
-	Values[InCategory] = InValue;
+	const float value = Schema ? Schema->Sanitize(InCategory, InValue) : InValue;
+	if (Values[InCategory] == value && Values.Written[InCategory])
+	{
+		return;
+	}
+	Values[InCategory] = value;
+	UpdateDirtyKey(InCategory);
 }
 
-bool UEasySettingsSetter::GetValue(uint8 InCategory, float& OutValue)
+void UEasySettingsSetter::UpdateDirtyKey(uint8 InCategory)
 {
 	if (!Values.Contains(InCategory))
+	{
+		return;
+	}
+	Values.Written[InCategory] = true;
+	DirtyKeys[InCategory] = !PersistedValues.IsWritten(InCategory) || PersistedValues[InCategory] != Values[InCategory];
+	ChangedKeys[InCategory] = true;
+	if (SharedValues.IsValid())
+	{
+		SharedValues->Publish(InCategory, Values[InCategory]);
+	}
+}
+
+void UEasySettingsSetter::SetSharedValues(TSharedPtr<FEasySettingsSharedValues, ESPMode::ThreadSafe> InSharedValues)
+{
+	SharedValues = MoveTemp(InSharedValues);
+	PublishValues();
+}
+
+void UEasySettingsSetter::PublishValues()
+{
+	if (SharedValues.IsValid())
+	{
+		SharedValues->Publish(Values);
+	}
+}
+
+void UEasySettingsSetter::MarkPersisted()
+{
+	PersistedValues = Values;
+	DirtyKeys = EasySettings::FKeyBits();
+	DirtyIntKeys = EasySettings::FKeyBits();
+	DirtyBoolKeys = EasySettings::FKeyBits();
+	DirtyVectorKeys = EasySettings::FKeyBits();
+	PersistedNamedValues = NamedValues;
+	DirtyNamedKeys.Init(false, NamedValues.Num());
+}
+
+bool UEasySettingsSetter::GetValue(uint8 InCategory, float& OutValue)
+{
+	const float* value = Values.Find(InCategory);
+	if (!value)
+	{
+		return false;
+	}
+	OutValue = *value;
+	return true;
+}
+
+int32 UEasySettingsSetter::GetValues(TArrayView<const uint8> InCategories, TArrayView<float> OutValues) const
+{
+	check(OutValues.Num() >= InCategories.Num());
+	int32 found = 0;
+	for (int32 i = 0; i < InCategories.Num(); ++i)
+	{
+		if (const float* value = Values.Find(InCategories[i]))
+		{
+			OutValues[i] = *value;
+			++found;
+		}
+	}
+	return found;
+}
+
+void UEasySettingsSetter::SetValues(TArrayView<const uint8> InCategories, TArrayView<const float> InValues)
+{
+	check(InValues.Num() >= InCategories.Num());
+	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UEasySettingsSetter, SetValue)))
+	{
+		// Let the Blueprint override react to every value
+		for (int32 i = 0; i < InCategories.Num(); ++i)
+		{
+			SetValue(InCategories[i], InValues[i]);
+		}
+		return;
+	}
+
+	EasySettings::FKeyBits writtenKeys;
+	int32 written = 0;
+	for (int32 i = 0; i < InCategories.Num(); ++i)
+	{
+		const uint8 category = InCategories[i];
+		if (!Values.Contains(category) || (Values[category] == InValues[i] && Values.Written[category]))
+		{
+			continue;
+		}
+		Values[category] = InValues[i];
+		writtenKeys[category] = true;
+		++written;
+	}
+	if (written == 0)
+	{
+		return;
+	}
+
+	// Validate the whole block at once instead of value by value
+	EasySettings::FKeyBits repairedKeys;
+	if (Schema)
+	{
+		Schema->SanitizeAll(Values, repairedKeys);
+	}
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		if (writtenKeys[i] || repairedKeys[i])
+		{
+			UpdateDirtyKey(static_cast<uint8>(i));
+		}
+	}
+}
+
+int32 UEasySettingsSetter::SanitizeValues()
+{
+	if (!Schema)
+	{
+		return 0;
+	}
+
+	EasySettings::FKeyBits repairedKeys;
+	const int32 repaired = Schema->SanitizeAll(Values, repairedKeys);
+	if (repaired == 0)
+	{
+		return 0;
+	}
+
+	FString keys;
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		if (!repairedKeys[i])
+		{
+			continue;
+		}
+		UpdateDirtyKey(static_cast<uint8>(i));
+		keys += keys.IsEmpty() ? FString::FromInt(i) : FString::Printf(TEXT(", %d"), i);
+	}
+	UE_LOG(LogEasySettings, Warning, TEXT("Repaired %d invalid or out of range container values: %s"), repaired, *keys);
+	return repaired;
+}
+
+void UEasySettingsSetter::SetSchema(const FEasySettingsSchema* InSchema)
+{
+	Schema = InSchema;
+	const TSharedRef<const EasySettings::FTypedLayout>& layout = Schema
+		                                                             ? Schema->GetLayout()
+		                                                             : EasySettings::FTypedLayout::GetEmpty();
+	if (&Values.Layout.Get() == &layout.Get())
+	{
+		return;
+	}
+	Values.SetLayout(layout);
+	PersistedValues.SetLayout(layout);
+	DirtyIntKeys = EasySettings::FKeyBits();
+	DirtyBoolKeys = EasySettings::FKeyBits();
+	DirtyVectorKeys = EasySettings::FKeyBits();
+}
+
+void UEasySettingsSetter::SetIntValue(uint8 InCategory, int32 InValue)
+{
+	int32* value = Values.FindInt(InCategory);
+	if (!value)
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Container category %d is not declared as Int in the value schema"), InCategory);
+		return;
+	}
+	if (*value == InValue)
+	{
+		return;
+	}
+	*value = InValue;
+	DirtyIntKeys[InCategory] = *PersistedValues.FindInt(InCategory) != InValue;
+	ChangedKeys[InCategory] = true;
+}
+
+bool UEasySettingsSetter::GetIntValue(uint8 InCategory, int32& OutValue) const
+{
+	const int32* value = Values.FindInt(InCategory);
+	if (!value)
+	{
+		return false;
+	}
+	OutValue = *value;
+	return true;
+}
+
+void UEasySettingsSetter::SetBoolValue(uint8 InCategory, bool bInValue)
+{
+	const int32 slot = Values.Layout->FindBoolSlot(InCategory);
+	if (slot == INDEX_NONE)
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Container category %d is not declared as Bool in the value schema"), InCategory);
+		return;
+	}
+	if (Values.Bools[slot] == bInValue)
+	{
+		return;
+	}
+	Values.Bools[slot] = bInValue;
+	DirtyBoolKeys[InCategory] = PersistedValues.Bools[slot] != bInValue;
+	ChangedKeys[InCategory] = true;
+}
+
+bool UEasySettingsSetter::GetBoolValue(uint8 InCategory, bool& bOutValue) const
+{
+	const int32 slot = Values.Layout->FindBoolSlot(InCategory);
+	if (slot == INDEX_NONE)
 	{
 		return false;
 	}
-	OutValue = Values[InCategory];
+	bOutValue = Values.Bools[slot];
 	return true;
 }
 
+void UEasySettingsSetter::SetVectorValue(uint8 InCategory, const FVector4f& InValue)
+{
+	FVector4f* value = Values.FindVector(InCategory);
+	if (!value)
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Container category %d is not declared as Vector in the value schema"), InCategory);
+		return;
+	}
+	if (*value == InValue)
+	{
+		return;
+	}
+	*value = InValue;
+	DirtyVectorKeys[InCategory] = *PersistedValues.FindVector(InCategory) != InValue;
+	ChangedKeys[InCategory] = true;
+}
+
+bool UEasySettingsSetter::GetVectorValue(uint8 InCategory, FVector4f& OutValue) const
+{
+	const FVector4f* value = Values.FindVector(InCategory);
+	if (!value)
+	{
+		return false;
+	}
+	OutValue = *value;
+	return true;
+}
+
+void UEasySettingsSetter::EnsureNamedSlot(int32 InSlot)
+{
+	if (InSlot < NamedValues.Num())
+	{
+		return;
+	}
+	NamedValues.SetNumZeroed(InSlot + 1);
+	PersistedNamedValues.SetNumZeroed(InSlot + 1);
+	DirtyNamedKeys.Add(false, InSlot + 1 - DirtyNamedKeys.Num());
+}
+
+void UEasySettingsSetter::SetNamedValue(int32 InSlot, float InValue)
+{
+	// Only a slot this setter has not stored yet needs the registry and its lock
+	if (!NamedValues.IsValidIndex(InSlot))
+	{
+		if (!FEasySettingsKeyRegistry::Get().IsValidSlot(InSlot))
+		{
+			return;
+		}
+		EnsureNamedSlot(InSlot);
+	}
+	if (NamedValues[InSlot] == InValue)
+	{
+		return;
+	}
+	NamedValues[InSlot] = InValue;
+	DirtyNamedKeys[InSlot] = PersistedNamedValues[InSlot] != InValue;
+}
+
+bool UEasySettingsSetter::GetNamedValue(int32 InSlot, float& OutValue) const
+{
+	if (NamedValues.IsValidIndex(InSlot))
+	{
+		OutValue = NamedValues[InSlot];
+		return true;
+	}
+	if (!FEasySettingsKeyRegistry::Get().IsValidSlot(InSlot))
+	{
+		return false;
+	}
+	// Registered, but never set
+	OutValue = 0.0f;
+	return true;
+}
+
+namespace EasySettingsSetterPrivate
+{
+	constexpr int32 PACKED_BOOLS_SIZE = (EasySettings::VALUES_NUM + 7) / 8;
+
+	/** Key layout of the current build: every key stored at its own index. */
+	struct FIdentityLayout
+	{
+		uint8 Keys[EasySettings::VALUES_NUM];
+
+		FIdentityLayout()
+		{
+			for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+			{
+				Keys[i] = static_cast<uint8>(i);
+			}
+		}
+	};
+
+	const FIdentityLayout& GetIdentityLayout()
+	{
+		static const FIdentityLayout layout;
+		return layout;
+	}
+
+	uint32 ComputeChecksum(const uint8* InKeys, int32 InNum, const void* InValues)
+	{
+		uint32 crc = FCrc::MemCrc32(InKeys, InNum);
+		return FCrc::MemCrc32(InValues, InNum * sizeof(EasySettings::MapValue), crc);
+	}
+
+	/** Packs the first `InNum` bits, eight per byte, lowest key in the lowest bit. */
+	template <typename BitsType>
+	void PackBools(const BitsType& InBits, int32 InNum, uint8* OutBytes)
+	{
+		FMemory::Memzero(OutBytes, (InNum + 7) / 8);
+		for (int32 i = 0; i < InNum; ++i)
+		{
+			OutBytes[i >> 3] |= static_cast<uint8>(InBits[i]) << (i & 7);
+		}
+	}
+
+	/** Writes a key name as its UTF-8 length (`uint16`) followed by the characters. */
+	void WriteKeyName(FArchive& Ar, const FString& InName)
+	{
+		FTCHARToUTF8 utf8(*InName);
+		uint16 length = static_cast<uint16>(FMath::Min<int32>(utf8.Length(), MAX_uint16));
+		Ar << length;
+		Ar.Serialize(const_cast<ANSICHAR*>(utf8.Get()), length);
+	}
+
+	bool ReadKeyName(FArchive& Ar, FString& OutName)
+	{
+		uint16 length = 0;
+		if (Ar.TotalSize() - Ar.Tell() < static_cast<int64>(sizeof(length)))
+		{
+			return false;
+		}
+		Ar << length;
+		if (Ar.TotalSize() - Ar.Tell() < length)
+		{
+			return false;
+		}
+		TArray<ANSICHAR, TInlineAllocator<64>> utf8;
+		utf8.SetNumUninitialized(length);
+		Ar.Serialize(utf8.GetData(), length);
+		FUTF8ToTCHAR name(utf8.GetData(), length);
+		OutName = FString(name.Length(), name.Get());
+		return true;
+	}
+
+	template <typename BitsType>
+	void UnpackBools(const uint8* InBytes, int32 InNum, BitsType& OutBits)
+	{
+		for (int32 i = 0; i < InNum; ++i)
+		{
+			OutBits[i] = ((InBytes[i >> 3] >> (i & 7)) & 1) != 0;
+		}
+	}
+}
+
 void UEasySettingsSetter::Read(FMemoryReader& MemoryReader)
 {
+	ReadResult = ReadVersioned(MemoryReader);
+}
+
+EasySettings::EReadResult UEasySettingsSetter::TryRead(FMemoryReader& MemoryReader)
+{
+	ReadResult = EasySettings::EReadResult::Loaded;
+	Read(MemoryReader);
+	return ReadResult;
+}
+
+EasySettings::EReadResult UEasySettingsSetter::ReadVersioned(FMemoryReader& MemoryReader)
+{
+	using namespace EasySettings;
 	InitializeEmpty();
+	if (MemoryReader.IsByteSwapping())
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("The container format is little-endian only, byte-swapped data is not read"));
+		return EReadResult::Failed;
+	}
+
+	const int64 startOffset = MemoryReader.Tell();
+	uint32 magic = 0;
+	if (MemoryReader.TotalSize() - startOffset >= static_cast<int64>(sizeof(magic)))
+	{
+		MemoryReader << magic;
+	}
+	if (magic != CONTAINER_MAGIC)
+	{
+		// Written before the format was versioned
+		MemoryReader.Seek(startOffset);
+		return ReadHeaderless(MemoryReader) ? EReadResult::Migrated : EReadResult::Failed;
+	}
+
+	uint16 version = 0;
+	uint16 valueSize = 0;
+	int32 count = 0;
+	MemoryReader << version;
+	MemoryReader << valueSize;
+	MemoryReader << count;
+	if (MemoryReader.IsError()
+		|| version == static_cast<uint16>(EContainerVersion::Headerless)
+		|| version > static_cast<uint16>(EContainerVersion::Latest)
+		|| valueSize != sizeof(MapValue)
+		|| count < 0)
+	{
+		return EReadResult::Failed;
+	}
+
+	const int64 payloadSize = count + static_cast<int64>(sizeof(uint32)) + count * static_cast<int64>(sizeof(MapValue));
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < payloadSize)
+	{
+		// Truncated data, keep the defaults
+		return EReadResult::Failed;
+	}
+
+	TArray<uint8> keys;
+	keys.SetNumUninitialized(count);
+	MemoryReader.Serialize(keys.GetData(), count);
+	uint32 checksum = 0;
+	MemoryReader << checksum;
+
+	const EasySettingsSetterPrivate::FIdentityLayout& identity = EasySettingsSetterPrivate::GetIdentityLayout();
+	const bool bSameLayout = count == VALUES_NUM && FMemory::Memcmp(keys.GetData(), identity.Keys, VALUES_NUM) == 0;
+	if (bSameLayout)
+	{
+		// Fast path: the stored block maps 1:1 onto the storage
+		MemoryReader.Serialize(Values.GetData(), count * sizeof(MapValue));
+		if (EasySettingsSetterPrivate::ComputeChecksum(keys.GetData(), count, Values.GetData()) != checksum)
+		{
+			InitializeEmpty();
+			return EReadResult::Failed;
+		}
+	}
+	else
+	{
+		TArray<MapValue> storedValues;
+		storedValues.SetNumUninitialized(count);
+		MemoryReader.Serialize(storedValues.GetData(), count * sizeof(MapValue));
+		if (EasySettingsSetterPrivate::ComputeChecksum(keys.GetData(), count, storedValues.GetData()) != checksum)
+		{
+			return EReadResult::Failed;
+		}
+
+		// Map each stored key onto its slot, keys unknown to this build are dropped
+		for (int32 i = 0; i < count; ++i)
+		{
+			if (Values.Contains(keys[i]))
+			{
+				Values[keys[i]] = storedValues[i];
+			}
+		}
+	}
+
+	// Sections added by later versions keep their defaults when reading older data
+	if ((version >= static_cast<uint16>(EContainerVersion::Typed) && !ReadTyped(MemoryReader, version))
+		|| (version >= static_cast<uint16>(EContainerVersion::Named) && !ReadNamed(MemoryReader))
+		|| (version >= static_cast<uint16>(EContainerVersion::Written) && !ReadWritten(MemoryReader)))
+	{
+		InitializeEmpty();
+		return EReadResult::Failed;
+	}
+	if (version < static_cast<uint16>(EContainerVersion::Written))
+	{
+		MarkNonZeroWritten();
+	}
+	MarkPersisted();
+	return bSameLayout && version == static_cast<uint16>(EContainerVersion::Latest)
+		       ? EReadResult::Loaded
+		       : EReadResult::Migrated;
+}
+
+bool UEasySettingsSetter::ReadTyped(FMemoryReader& MemoryReader, uint16 InVersion)
+{
+	using namespace EasySettings;
+	if (InVersion < static_cast<uint16>(EContainerVersion::Sparse))
+	{
+		return ReadDenseTyped(MemoryReader);
+	}
+
+	int32 size = 0;
+	uint32 checksum = 0;
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < static_cast<int64>(sizeof(size) + sizeof(checksum)))
+	{
+		return false;
+	}
+	MemoryReader << size;
+	MemoryReader << checksum;
+	if (size < 0 || MemoryReader.TotalSize() - MemoryReader.Tell() < size)
+	{
+		return false;
+	}
+
+	TArray<uint8> section;
+	section.SetNumUninitialized(size);
+	MemoryReader.Serialize(section.GetData(), size);
+	if (FCrc::MemCrc32(section.GetData(), size) != checksum)
+	{
+		return false;
+	}
+
+	// Each block is its keys followed by their values, stored keys that are not declared with that type are dropped
+	FMemoryReader sectionReader(section);
+	TArray<uint8> keys;
+	auto readKeys = [&sectionReader, &keys](int64 InValueSize) -> bool
+	{
+		int32 count = 0;
+		if (sectionReader.TotalSize() - sectionReader.Tell() < static_cast<int64>(sizeof(count)))
+		{
+			return false;
+		}
+		sectionReader << count;
+		const int64 valuesSize = InValueSize > 0 ? count * InValueSize : (count + 7) / 8;
+		if (count < 0 || sectionReader.TotalSize() - sectionReader.Tell() < count + valuesSize)
+		{
+			return false;
+		}
+		keys.SetNumUninitialized(count);
+		sectionReader.Serialize(keys.GetData(), count);
+		return true;
+	};
+
+	const FTypedLayout& layout = *Values.Layout;
+	if (!readKeys(sizeof(int32)))
+	{
+		return false;
+	}
+	for (uint8 key : keys)
+	{
+		int32 value = 0;
+		sectionReader.Serialize(&value, sizeof(value));
+		if (int32* slot = Values.FindInt(key))
+		{
+			*slot = value;
+		}
+	}
+
+	if (!readKeys(0))
+	{
+		return false;
+	}
+	TArray<uint8, TInlineAllocator<EasySettingsSetterPrivate::PACKED_BOOLS_SIZE>> bools;
+	bools.SetNumUninitialized((keys.Num() + 7) / 8);
+	sectionReader.Serialize(bools.GetData(), bools.Num());
+	for (int32 i = 0; i < keys.Num(); ++i)
+	{
+		const int32 slot = layout.FindBoolSlot(keys[i]);
+		if (slot != INDEX_NONE)
+		{
+			Values.Bools[slot] = ((bools[i >> 3] >> (i & 7)) & 1) != 0;
+		}
+	}
+
+	if (!readKeys(sizeof(FVector4f)))
+	{
+		return false;
+	}
+	for (uint8 key : keys)
+	{
+		FVector4f value;
+		sectionReader.Serialize(&value, sizeof(value));
+		if (FVector4f* slot = Values.FindVector(key))
+		{
+			*slot = value;
+		}
+	}
+	return true;
+}
+
+bool UEasySettingsSetter::ReadDenseTyped(FMemoryReader& MemoryReader)
+{
+	using namespace EasySettings;
+	int32 count = 0;
+	uint32 checksum = 0;
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < static_cast<int64>(sizeof(count) + sizeof(checksum)))
+	{
+		return false;
+	}
+	MemoryReader << count;
+	MemoryReader << checksum;
+	if (count < 0)
+	{
+		return false;
+	}
+
+	const int64 intsSize = count * static_cast<int64>(sizeof(int32));
+	const int64 boolsSize = (count + 7) / 8;
+	const int64 vectorsSize = count * static_cast<int64>(sizeof(FVector4f));
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < intsSize + boolsSize + vectorsSize)
+	{
+		return false;
+	}
+
+	TArray<uint8> block;
+	block.SetNumUninitialized(intsSize + boolsSize + vectorsSize);
+	MemoryReader.Serialize(block.GetData(), block.Num());
+	const uint8* ints = block.GetData();
+	const uint8* bools = ints + intsSize;
+	const uint8* vectors = bools + boolsSize;
+
+	uint32 crc = FCrc::MemCrc32(ints, intsSize);
+	crc = FCrc::MemCrc32(bools, boolsSize, crc);
+	crc = FCrc::MemCrc32(vectors, vectorsSize, crc);
+	if (crc != checksum)
+	{
+		return false;
+	}
+
+	// Each block is indexed by key, only the declared keys are kept
+	const FTypedLayout& layout = *Values.Layout;
+	for (int32 slot = 0; slot < layout.IntKeys.Num(); ++slot)
+	{
+		const int32 key = layout.IntKeys[slot];
+		if (key < count)
+		{
+			FMemory::Memcpy(&Values.Ints[slot], ints + key * sizeof(int32), sizeof(int32));
+		}
+	}
+	for (int32 slot = 0; slot < layout.BoolKeys.Num(); ++slot)
+	{
+		const int32 key = layout.BoolKeys[slot];
+		Values.Bools[slot] = key < count && ((bools[key >> 3] >> (key & 7)) & 1) != 0;
+	}
+	for (int32 slot = 0; slot < layout.VectorKeys.Num(); ++slot)
+	{
+		const int32 key = layout.VectorKeys[slot];
+		if (key < count)
+		{
+			FMemory::Memcpy(&Values.Vectors[slot], vectors + key * sizeof(FVector4f), sizeof(FVector4f));
+		}
+	}
+	return true;
+}
+
+bool UEasySettingsSetter::ReadNamed(FMemoryReader& MemoryReader)
+{
+	int32 count = 0;
+	int32 size = 0;
+	uint32 checksum = 0;
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < static_cast<int64>(sizeof(count) + sizeof(size) + sizeof(checksum)))
+	{
+		return false;
+	}
+	MemoryReader << count;
+	MemoryReader << size;
+	MemoryReader << checksum;
+	if (count < 0 || size < 0 || MemoryReader.TotalSize() - MemoryReader.Tell() < size)
+	{
+		return false;
+	}
+
+	TArray<uint8> section;
+	section.SetNumUninitialized(size);
+	MemoryReader.Serialize(section.GetData(), size);
+	if (FCrc::MemCrc32(section.GetData(), size) != checksum)
+	{
+		return false;
+	}
+
+	FMemoryReader sectionReader(section);
+	TArray<FString> names;
+	names.SetNum(count);
+	for (FString& name : names)
+	{
+		if (!EasySettingsSetterPrivate::ReadKeyName(sectionReader, name))
+		{
+			return false;
+		}
+	}
+	if (sectionReader.TotalSize() - sectionReader.Tell() < count * static_cast<int64>(sizeof(float)))
+	{
+		return false;
+	}
+	TArray<float> storedValues;
+	storedValues.SetNumUninitialized(count);
+	sectionReader.Serialize(storedValues.GetData(), count * sizeof(float));
+
+	// Slots depend on registration order, the names tie each value to its key
+	FEasySettingsKeyRegistry& registry = FEasySettingsKeyRegistry::Get();
+	for (int32 i = 0; i < count; ++i)
+	{
+		const int32 slot = registry.Resolve(names[i]);
+		if (slot == INDEX_NONE)
+		{
+			continue;
+		}
+		EnsureNamedSlot(slot);
+		NamedValues[slot] = storedValues[i];
+	}
+	return true;
+}
+
+void UEasySettingsSetter::WriteNamed(FMemoryWriter& MemoryWriter) const
+{
+	int32 count = NamedValues.Num();
+	TArray<uint8> section;
+	FMemoryWriter sectionWriter(section);
+	const FEasySettingsKeyRegistry& registry = FEasySettingsKeyRegistry::Get();
+	for (int32 i = 0; i < count; ++i)
+	{
+		EasySettingsSetterPrivate::WriteKeyName(sectionWriter, registry.GetName(i));
+	}
+	sectionWriter.Serialize(const_cast<float*>(NamedValues.GetData()), count * sizeof(float));
+
+	int32 size = section.Num();
+	uint32 checksum = FCrc::MemCrc32(section.GetData(), size);
+	MemoryWriter << count;
+	MemoryWriter << size;
+	MemoryWriter << checksum;
+	MemoryWriter.Serialize(section.GetData(), size);
+}
+
+bool UEasySettingsSetter::ReadWritten(FMemoryReader& MemoryReader)
+{
+	uint8 bits[EasySettingsSetterPrivate::PACKED_BOOLS_SIZE];
+	uint32 checksum = 0;
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < static_cast<int64>(sizeof(bits) + sizeof(checksum)))
+	{
+		return false;
+	}
+	MemoryReader.Serialize(bits, sizeof(bits));
+	MemoryReader << checksum;
+	if (FCrc::MemCrc32(bits, sizeof(bits)) != checksum)
+	{
+		return false;
+	}
+	EasySettingsSetterPrivate::UnpackBools(bits, EasySettings::VALUES_NUM, Values.Written);
+	// Only slots holding a value can have been written
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		Values.Written[i] = Values.Written[i] && Values.Present[i];
+	}
+	return true;
+}
+
+void UEasySettingsSetter::WriteWritten(FMemoryWriter& MemoryWriter) const
+{
+	uint8 bits[EasySettingsSetterPrivate::PACKED_BOOLS_SIZE];
+	EasySettingsSetterPrivate::PackBools(Values.Written, EasySettings::VALUES_NUM, bits);
+	uint32 checksum = FCrc::MemCrc32(bits, sizeof(bits));
+	MemoryWriter.Serialize(bits, sizeof(bits));
+	MemoryWriter << checksum;
+}
+
+void UEasySettingsSetter::MarkNonZeroWritten()
+{
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		Values.Written[i] = Values.Present[i] && Values.Values[i] != 0.0f;
+	}
+}
+
+void UEasySettingsSetter::WriteTyped(FMemoryWriter& MemoryWriter) const
+{
+	using namespace EasySettings;
+	const FTypedLayout& layout = *Values.Layout;
+	TArray<uint8> section;
+	FMemoryWriter sectionWriter(section);
+
+	// Each type is written as its declared keys followed by one contiguous block of values
+	int32 intCount = layout.IntKeys.Num();
+	sectionWriter << intCount;
+	sectionWriter.Serialize(const_cast<uint8*>(layout.IntKeys.GetData()), intCount);
+	sectionWriter.Serialize(const_cast<int32*>(Values.Ints.GetData()), intCount * sizeof(int32));
+
+	int32 boolCount = layout.BoolKeys.Num();
+	uint8 bools[EasySettingsSetterPrivate::PACKED_BOOLS_SIZE];
+	EasySettingsSetterPrivate::PackBools(Values.Bools, boolCount, bools);
+	sectionWriter << boolCount;
+	sectionWriter.Serialize(const_cast<uint8*>(layout.BoolKeys.GetData()), boolCount);
+	sectionWriter.Serialize(bools, (boolCount + 7) / 8);
+
+	int32 vectorCount = layout.VectorKeys.Num();
+	sectionWriter << vectorCount;
+	sectionWriter.Serialize(const_cast<uint8*>(layout.VectorKeys.GetData()), vectorCount);
+	sectionWriter.Serialize(const_cast<FVector4f*>(Values.Vectors.GetData()), vectorCount * sizeof(FVector4f));
+
+	int32 size = section.Num();
+	uint32 checksum = FCrc::MemCrc32(section.GetData(), size);
+	MemoryWriter << size;
+	MemoryWriter << checksum;
+	MemoryWriter.Serialize(section.GetData(), size);
+}
+
+bool UEasySettingsSetter::ReadHeaderless(FMemoryReader& MemoryReader)
+{
 	int32 n = EasySettings::VALUES_NUM;
-	// Read each element
-	for (uint8 i = 0; i < n; ++i)
+	if (MemoryReader.TotalSize() - MemoryReader.Tell() < n * static_cast<int64>(sizeof(EasySettings::MapValue)))
 	{
-		float elementValue;
-		MemoryReader << elementValue;
-		Values[i] = elementValue;
+		// Truncated data, keep the defaults
+		return false;
 	}
+
+	// Copy the whole block at once
+	MemoryReader.Serialize(Values.GetData(), n * sizeof(EasySettings::MapValue));
+	MarkNonZeroWritten();
+	MarkPersisted();
+	return true;
 }
 
 void UEasySettingsSetter::Write(FMemoryWriter& MemoryWriter)
 {
-	int n = EasySettings::VALUES_NUM;
-	check((Values.Num() == n));
-	// Write each float element
-	for (TTuple<uint8, float> el : Values)
+	using namespace EasySettings;
+	if (MemoryWriter.IsByteSwapping())
 	{
-		MemoryWriter << el.Value;
+		UE_LOG(LogEasySettings, Warning, TEXT("The container format is little-endian only, byte-swapped data is not written"));
+		return;
+	}
+	uint32 magic = CONTAINER_MAGIC;
+	uint16 version = static_cast<uint16>(EContainerVersion::Latest);
+	uint16 valueSize = sizeof(MapValue);
+	int32 count = VALUES_NUM;
+	const EasySettingsSetterPrivate::FIdentityLayout& identity = EasySettingsSetterPrivate::GetIdentityLayout();
+	uint32 checksum = EasySettingsSetterPrivate::ComputeChecksum(identity.Keys, count, Values.GetData());
+
+	MemoryWriter << magic;
+	MemoryWriter << version;
+	MemoryWriter << valueSize;
+	MemoryWriter << count;
+	MemoryWriter.Serialize(const_cast<uint8*>(identity.Keys), count);
+	MemoryWriter << checksum;
+	// Copy the whole block at once
+	MemoryWriter.Serialize(Values.GetData(), count * sizeof(MapValue));
+	WriteTyped(MemoryWriter);
+	WriteNamed(MemoryWriter);
+	WriteWritten(MemoryWriter);
+}
+
+int32 UEasySettingsSetter::WriteJournal(FMemoryWriter& MemoryWriter)
+{
+	int32 written = 0;
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		if (!DirtyKeys[i])
+		{
+			continue;
+		}
+		uint8 kind = static_cast<uint8>(EasySettings::EJournalRecord::Float);
+		uint8 key = static_cast<uint8>(i);
+		MemoryWriter << kind;
+		MemoryWriter << key;
+		MemoryWriter << Values[key];
+		++written;
+	}
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		uint8 key = static_cast<uint8>(i);
+		if (DirtyIntKeys[i])
+		{
+			uint8 kind = static_cast<uint8>(EasySettings::EJournalRecord::Int);
+			MemoryWriter << kind;
+			MemoryWriter << key;
+			MemoryWriter << *Values.FindInt(key);
+			++written;
+		}
+		if (DirtyBoolKeys[i])
+		{
+			uint8 kind = static_cast<uint8>(EasySettings::EJournalRecord::Bool);
+			uint8 value = Values.Bools[Values.Layout->FindBoolSlot(key)] ? 1 : 0;
+			MemoryWriter << kind;
+			MemoryWriter << key;
+			MemoryWriter << value;
+			++written;
+		}
+		if (DirtyVectorKeys[i])
+		{
+			uint8 kind = static_cast<uint8>(EasySettings::EJournalRecord::Vector);
+			MemoryWriter << kind;
+			MemoryWriter << key;
+			MemoryWriter.Serialize(Values.FindVector(key), sizeof(FVector4f));
+			++written;
+		}
+	}
+
+	const FEasySettingsKeyRegistry& registry = FEasySettingsKeyRegistry::Get();
+	for (TConstSetBitIterator<> it(DirtyNamedKeys); it; ++it)
+	{
+		uint8 kind = static_cast<uint8>(EasySettings::EJournalRecord::Named);
+		MemoryWriter << kind;
+		EasySettingsSetterPrivate::WriteKeyName(MemoryWriter, registry.GetName(it.GetIndex()));
+		MemoryWriter << NamedValues[it.GetIndex()];
+		++written;
+	}
+	return written;
+}
+
+int32 UEasySettingsSetter::ReplayJournal(FMemoryReader& MemoryReader)
+{
+	using namespace EasySettings;
+	constexpr int64 recordHeaderSize = sizeof(uint8) + sizeof(MapKey);
+	int32 applied = 0;
+	while (MemoryReader.TotalSize() - MemoryReader.Tell() >= recordHeaderSize)
+	{
+		uint8 kind = 0;
+		MemoryReader << kind;
+		if (kind == static_cast<uint8>(EJournalRecord::Named))
+		{
+			FString name;
+			if (!EasySettingsSetterPrivate::ReadKeyName(MemoryReader, name)
+				|| MemoryReader.TotalSize() - MemoryReader.Tell() < static_cast<int64>(sizeof(float)))
+			{
+				break;
+			}
+			float value = 0.0f;
+			MemoryReader << value;
+			const int32 slot = FEasySettingsKeyRegistry::Get().Resolve(name);
+			if (slot != INDEX_NONE)
+			{
+				EnsureNamedSlot(slot);
+				NamedValues[slot] = value;
+			}
+			++applied;
+			continue;
+		}
+
+		uint8 key = 0;
+		MemoryReader << key;
+
+		int64 valueSize = 0;
+		switch (static_cast<EJournalRecord>(kind))
+		{
+		case EJournalRecord::Float: valueSize = sizeof(MapValue); break;
+		case EJournalRecord::Int: valueSize = sizeof(int32); break;
+		case EJournalRecord::Bool: valueSize = sizeof(uint8); break;
+		case EJournalRecord::Vector: valueSize = sizeof(FVector4f); break;
+		default: break;
+		}
+		if (valueSize == 0 || MemoryReader.TotalSize() - MemoryReader.Tell() < valueSize)
+		{
+			// Unknown, corrupted or truncated record, nothing after it can be trusted
+			break;
+		}
+
+		switch (static_cast<EJournalRecord>(kind))
+		{
+		case EJournalRecord::Float:
+			{
+				float value = 0.0f;
+				MemoryReader << value;
+				if (Values.Contains(key))
+				{
+					Values[key] = value;
+					Values.Written[key] = true;
+				}
+				break;
+			}
+		case EJournalRecord::Int:
+			{
+				int32 value = 0;
+				MemoryReader << value;
+				if (int32* slot = Values.FindInt(key))
+				{
+					*slot = value;
+				}
+				break;
+			}
+		case EJournalRecord::Bool:
+			{
+				uint8 value = 0;
+				MemoryReader << value;
+				const int32 slot = Values.Layout->FindBoolSlot(key);
+				if (slot != INDEX_NONE)
+				{
+					Values.Bools[slot] = value != 0;
+				}
+				break;
+			}
+		default:
+			{
+				FVector4f value;
+				MemoryReader.Serialize(&value, sizeof(FVector4f));
+				if (FVector4f* slot = Values.FindVector(key))
+				{
+					*slot = value;
+				}
+				break;
+			}
+		}
+		++applied;
 	}
+	MarkPersisted();
+	return applied;
 }
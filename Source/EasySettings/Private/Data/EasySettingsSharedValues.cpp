@@ -0,0 +1,96 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/EasySettingsSharedValues.h"
+
+static_assert(std::atomic<float>::is_always_lock_free, "Shared container values require lock-free float atomics");
+
+FEasySettingsSharedValues::FEasySettingsSharedValues()
+	: Sequence(0)
+{
+	for (std::atomic<float>& value : Values)
+	{
+		value.store(0.0f, std::memory_order_relaxed);
+	}
+	for (std::atomic<uint32>& bits : PresentBits)
+	{
+		bits.store(0, std::memory_order_relaxed);
+	}
+}
+
+void FEasySettingsSharedValues::BeginWrite()
+{
+	check(IsInGameThread());
+	Sequence.store(Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+void FEasySettingsSharedValues::EndWrite()
+{
+	Sequence.store(Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void FEasySettingsSharedValues::Publish(const EasySettings::FContainer& InValues)
+{
+	BeginWrite();
+	for (int32 i = 0; i < EasySettings::VALUES_CAPACITY; ++i)
+	{
+		Values[i].store(InValues.Values[i], std::memory_order_relaxed);
+	}
+	for (int32 word = 0; word < PRESENT_WORDS; ++word)
+	{
+		uint32 bits = 0;
+		for (int32 bit = 0; bit < 32; ++bit)
+		{
+			bits |= static_cast<uint32>(InValues.Present[word * 32 + bit]) << bit;
+		}
+		PresentBits[word].store(bits, std::memory_order_relaxed);
+	}
+	EndWrite();
+}
+
+void FEasySettingsSharedValues::Publish(uint8 InCategory, float InValue)
+{
+	BeginWrite();
+	Values[InCategory].store(InValue, std::memory_order_relaxed);
+	EndWrite();
+}
+
+bool FEasySettingsSharedValues::GetValue(uint8 InCategory, float& OutValue) const
+{
+	if ((PresentBits[InCategory / 32].load(std::memory_order_acquire) & (1u << (InCategory % 32))) == 0)
+		return false;
+
+	OutValue = Values[InCategory].load(std::memory_order_acquire);
+	return true;
+}
+
+int32 FEasySettingsSharedValues::GetValues(TArrayView<const uint8> InCategories, TArrayView<float> OutValues) const
+{
+	check(OutValues.Num() >= InCategories.Num());
+	for (;;)
+	{
+		const uint32 sequence = Sequence.load(std::memory_order_acquire);
+		if (sequence & 1)
+		{
+			// The game thread is in the middle of a publish, which only takes a few stores
+			FPlatformProcess::Yield();
+			continue;
+		}
+
+		int32 found = 0;
+		for (int32 i = 0; i < InCategories.Num(); ++i)
+		{
+			const uint8 category = InCategories[i];
+			if (PresentBits[category / 32].load(std::memory_order_relaxed) & (1u << (category % 32)))
+			{
+				OutValues[i] = Values[category].load(std::memory_order_relaxed);
+				++found;
+			}
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Sequence.load(std::memory_order_relaxed) == sequence)
+			return found;
+	}
+}
@@ -2,17 +2,101 @@
 
 #include "EasySettings.h"
 
+#include "Data/EasySettingsConsoleVariableRegistry.h"
+#include "Data/EasySettingsContainerLoader.h"
+#include "Data/EasySettingsSetter.h"
+#include "Libs/EasySettingsLib.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Scalability.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/Package.h"
+
 #define LOCTEXT_NAMESPACE "FEasySettingsModule"
 
+DEFINE_LOG_CATEGORY(LogEasySettings);
+
 void FEasySettingsModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	if (developerSettings->bApplySettingsEarly)
+	{
+		ApplyEarlySettings();
+	}
+	else if (developerSettings->bAsyncContainerLoad)
+	{
+		// Start reading the container while the engine keeps initializing
+		PendingContainerLoad = FEasySettingsContainerLoader::Start(
+			UEasySettingsLib::GetContainerSavePath(),
+			UEasySettingsLib::GetContainerJournalPath());
+	}
 }
 
 void FEasySettingsModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	PendingContainerLoad.Reset();
+}
+
+void FEasySettingsModule::ApplyEarlySettings()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(EasySettings_ApplyEarlySettings);
+
+	// The engine loads the user scalability groups again later, applying them now avoids a second round of changes.
+	// The editor keeps its own viewport scalability in the editor settings, the game ones must not override it
+	if (!GIsEditor)
+	{
+		Scalability::LoadState(GGameUserSettingsIni);
+	}
+
+	const FString path = UEasySettingsLib::GetContainerSavePath();
+	FEasySettingsContainerLoader::FResult loadResult = FEasySettingsContainerLoader::Load(
+		path, UEasySettingsLib::GetContainerJournalPath());
+
+	const TArray<FEasySettingsConsoleVariableEntry>& entries =
+		UEasySettingsLib::GetDeveloperSettings()->ConsoleVariableSettings;
+	if (entries.Num() > 0)
+	{
+		// Only the file format matters here, the configured setter class is created by the subsystem
+		UEasySettingsSetter* setter = NewObject<UEasySettingsSetter>(GetTransientPackage());
+		setter->InitializeEmpty();
+		if (loadResult.bReadSucceeded)
+		{
+			FMemoryReader reader(loadResult.Bytes);
+			if (setter->TryRead(reader) != EasySettings::EReadResult::Failed && loadResult.JournalBytes.Num() > 0)
+			{
+				FMemoryReader journalReader(loadResult.JournalBytes);
+				setter->ReplayJournal(journalReader);
+			}
+		}
+
+		FEasySettingsConsoleVariableRegistry registry;
+		registry.Build(entries);
+		const EasySettings::FContainer& values = setter->GetValues();
+		for (int32 i = 0; i < registry.Num(); ++i)
+		{
+			const FEasySettingsConsoleVariableEntry& entry = registry.GetEntry(i);
+			if (!entry.bPersist || !values.Contains(entry.ContainerKey))
+				continue;
+			// Keys never written get the declared default, like the subsystem stores it. Variables of modules that
+			// are not loaded yet are restored by the subsystem.
+			registry.SetValue(i, values.IsWritten(entry.ContainerKey) ? values[entry.ContainerKey] : entry.Default);
+		}
+	}
+
+	// The subsystem finishes the load from these bytes instead of reading the file again
+	PendingContainerLoad = FEasySettingsContainerLoader::FromResult(path, MoveTemp(loadResult));
+}
+
+TSharedPtr<FEasySettingsContainerLoader, ESPMode::ThreadSafe> FEasySettingsModule::TakePendingContainerLoad(
+	const FString& InPath)
+{
+	if (!PendingContainerLoad.IsValid() || PendingContainerLoad->GetPath() != InPath)
+	{
+		return nullptr;
+	}
+	return MoveTemp(PendingContainerLoad);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,115 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EasySettingsStats.h"
+
+#include "EasySettings.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_EasySettings_ApplySettings);
+DEFINE_STAT(STAT_EasySettings_EngineApply);
+DEFINE_STAT(STAT_EasySettings_ApplyResolution);
+DEFINE_STAT(STAT_EasySettings_EngineSave);
+DEFINE_STAT(STAT_EasySettings_SaveContainer);
+DEFINE_STAT(STAT_EasySettings_Serialize);
+DEFINE_STAT(STAT_EasySettings_CompressWrite);
+DEFINE_STAT(STAT_EasySettings_AppendJournal);
+DEFINE_STAT(STAT_EasySettings_JournalWrite);
+DEFINE_STAT(STAT_EasySettings_ReadDecompress);
+DEFINE_STAT(STAT_EasySettings_LoadWait);
+DEFINE_STAT(STAT_EasySettings_LoadContainer);
+DEFINE_STAT(STAT_EasySettings_Deserialize);
+
+CSV_DEFINE_CATEGORY(EasySettings, true);
+
+namespace EasySettings::Stats
+{
+	struct FAtomicCounters
+	{
+		std::atomic<int64> Calls{0};
+		std::atomic<uint64> TotalCycles{0};
+		std::atomic<uint64> MaxCycles{0};
+	};
+
+	static FAtomicCounters Counters[static_cast<int32>(EPhase::Num)];
+
+	const TCHAR* GetPhaseName(EPhase InPhase)
+	{
+		switch (InPhase)
+		{
+		case EPhase::ApplySettings: return TEXT("ApplySettings");
+		case EPhase::EngineApply: return TEXT("EngineApply");
+		case EPhase::ApplyResolution: return TEXT("ApplyResolution");
+		case EPhase::EngineSave: return TEXT("EngineSave");
+		case EPhase::SaveContainer: return TEXT("SaveContainer");
+		case EPhase::Serialize: return TEXT("Serialize");
+		case EPhase::CompressWrite: return TEXT("CompressWrite");
+		case EPhase::AppendJournal: return TEXT("AppendJournal");
+		case EPhase::JournalWrite: return TEXT("JournalWrite");
+		case EPhase::ReadDecompress: return TEXT("ReadDecompress");
+		case EPhase::LoadWait: return TEXT("LoadWait");
+		case EPhase::LoadContainer: return TEXT("LoadContainer");
+		case EPhase::Deserialize: return TEXT("Deserialize");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	void Record(EPhase InPhase, uint64 InCycles)
+	{
+		FAtomicCounters& counters = Counters[static_cast<int32>(InPhase)];
+		counters.Calls.fetch_add(1, std::memory_order_relaxed);
+		counters.TotalCycles.fetch_add(InCycles, std::memory_order_relaxed);
+
+		uint64 max = counters.MaxCycles.load(std::memory_order_relaxed);
+		while (InCycles > max && !counters.MaxCycles.compare_exchange_weak(max, InCycles, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	FPhaseCounters GetCounters(EPhase InPhase)
+	{
+		const FAtomicCounters& counters = Counters[static_cast<int32>(InPhase)];
+		FPhaseCounters result;
+		result.Calls = counters.Calls.load(std::memory_order_relaxed);
+		result.TotalMs = FPlatformTime::ToMilliseconds64(counters.TotalCycles.load(std::memory_order_relaxed));
+		result.MaxMs = FPlatformTime::ToMilliseconds64(counters.MaxCycles.load(std::memory_order_relaxed));
+		return result;
+	}
+
+	void Reset()
+	{
+		for (FAtomicCounters& counters : Counters)
+		{
+			counters.Calls.store(0, std::memory_order_relaxed);
+			counters.TotalCycles.store(0, std::memory_order_relaxed);
+			counters.MaxCycles.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void Dump(const TArray<FString>& InArgs)
+	{
+		if (InArgs.Num() > 0 && InArgs[0] == TEXT("Reset"))
+		{
+			Reset();
+			UE_LOG(LogEasySettings, Display, TEXT("Settings counters reset"));
+			return;
+		}
+
+		UE_LOG(LogEasySettings, Display, TEXT("Settings counters (calls | total ms | avg ms | max ms)"));
+		for (int32 i = 0; i < static_cast<int32>(EPhase::Num); ++i)
+		{
+			const EPhase phase = static_cast<EPhase>(i);
+			const FPhaseCounters counters = GetCounters(phase);
+			UE_LOG(LogEasySettings, Display, TEXT("  %-16s %8lld | %10.3f | %8.3f | %8.3f"), GetPhaseName(phase),
+			       counters.Calls, counters.TotalMs, counters.TotalMs / FMath::Max<int64>(counters.Calls, 1),
+			       counters.MaxMs);
+		}
+	}
+
+	static FAutoConsoleCommand DumpCommand(
+		TEXT("EasySettings.Stats"),
+		TEXT("Prints cumulative call counts and timings of the settings apply, save and load phases. ")
+		TEXT("Usage: EasySettings.Stats [Reset]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Dump));
+}
@@ -0,0 +1,95 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("EasySettings"), STATGROUP_EasySettings, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Settings"), STAT_EasySettings_ApplySettings, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Engine Apply"), STAT_EasySettings_EngineApply, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Resolution"), STAT_EasySettings_ApplyResolution, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Engine Save"), STAT_EasySettings_EngineSave, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Container"), STAT_EasySettings_SaveContainer, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_EasySettings_Serialize, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compress And Write"), STAT_EasySettings_CompressWrite, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Append Journal"), STAT_EasySettings_AppendJournal, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Journal Write"), STAT_EasySettings_JournalWrite, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Read And Decompress"), STAT_EasySettings_ReadDecompress, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Wait"), STAT_EasySettings_LoadWait, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Container"), STAT_EasySettings_LoadContainer, STATGROUP_EasySettings, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Deserialize"), STAT_EasySettings_Deserialize, STATGROUP_EasySettings, );
+
+CSV_DECLARE_CATEGORY_EXTERN(EasySettings);
+
+namespace EasySettings::Stats
+{
+	/** Instrumented phases of the apply, save and load paths. */
+	enum class EPhase : uint8
+	{
+		ApplySettings,
+		EngineApply,
+		ApplyResolution,
+		EngineSave,
+		SaveContainer,
+		Serialize,
+		CompressWrite,
+		AppendJournal,
+		JournalWrite,
+		ReadDecompress,
+		LoadWait,
+		LoadContainer,
+		Deserialize,
+		Num
+	};
+
+	/** Cumulative timings of a phase since startup or the last `Reset`. */
+	struct FPhaseCounters
+	{
+		int64 Calls = 0;
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+	};
+
+	const TCHAR* GetPhaseName(EPhase InPhase);
+
+	/** Thread safe, phases may run on the game thread or on background tasks. */
+	void Record(EPhase InPhase, uint64 InCycles);
+
+	FPhaseCounters GetCounters(EPhase InPhase);
+
+	void Reset();
+
+	/** Records the time spent in its scope into the cumulative counters. */
+	class FPhaseScope
+	{
+	public:
+		explicit FPhaseScope(EPhase InPhase)
+			: Phase(InPhase)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+		}
+
+		~FPhaseScope()
+		{
+			Record(Phase, FPlatformTime::Cycles64() - StartCycles);
+		}
+
+	private:
+		EPhase Phase;
+		uint64 StartCycles;
+	};
+}
+
+/**
+ * Instruments the rest of the enclosing scope as one phase: stat cycle counter, Insights CPU event, CSV timing and
+ * cumulative counters. At most one phase scope per C++ scope.
+ */
+#define EASYSETTINGS_PHASE_SCOPE(Phase) \
+	SCOPE_CYCLE_COUNTER(STAT_EasySettings_##Phase); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(EasySettings_##Phase); \
+	CSV_SCOPED_TIMING_STAT(EasySettings, Phase); \
+	EasySettings::Stats::FPhaseScope EasySettingsPhaseScope(EasySettings::Stats::EPhase::Phase)
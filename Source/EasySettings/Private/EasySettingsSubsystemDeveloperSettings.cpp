@@ -10,4 +10,29 @@ UEasySettingsSubsystemDeveloperSettings::UEasySettingsSubsystemDeveloperSettings
 {
 	SettingsSetterClass = UEasySettingsSetter::StaticClass();
 	ContainerSaveName = "Config.bin";
+	bAsyncContainerSave = true;
+	bAsyncContainerLoad = true;
+	bApplySettingsEarly = false;
+	bJournalContainerChanges = false;
+	JournalCompactionThreshold = 4096;
+	bAutoDetectSettings = false;
+	AutoDetectDelayFrames = 10;
+	AutoDetectWorkScale = 10;
+	AutoDetectMaxResolutionHeights = {720, 1080, 1440, 0, 0};
+	AutoDetectFrameRateLimits = {30, 60, 60, 0, 0};
+	bEnableQualityGovernor = false;
+	GovernorTargetFrameRate = 60.0f;
+	GovernorOverBudgetRatio = 1.1f;
+	GovernorHeadroomRatio = 0.75f;
+	GovernorStepDownSeconds = 2.0f;
+	GovernorStepUpSeconds = 8.0f;
+	GovernorMinQuality = 0;
+	GovernorStepOrder = {ESettingsType::TYPE_Shadows, ESettingsType::TYPE_Effects, ESettingsType::TYPE_Details};
+	CostProfileGroups = {
+		ESettingsType::TYPE_AA, ESettingsType::TYPE_Textures, ESettingsType::TYPE_Effects, ESettingsType::TYPE_Details,
+		ESettingsType::TYPE_Shadows
+	};
+	CostProfileMaxQuality = 3;
+	CostProfileWarmupSeconds = 2.0f;
+	CostProfileSampleSeconds = 5.0f;
 }
@@ -3,6 +3,11 @@
 
 #include "Libs/EasySettingsLib.h"
 
+namespace EasySettingsLibPrivate
+{
+	FString ContainerSavePathOverride;
+}
+
 TSubclassOf<UEasySettingsSetter> UEasySettingsLib::GetSettingsSetterClass()
 {
 	return GetDeveloperSettings()->SettingsSetterClass;
@@ -13,6 +18,32 @@ FString UEasySettingsLib::GetContainerSaveName()
 	return GetDeveloperSettings()->ContainerSaveName;
 }
 
+FString UEasySettingsLib::GetContainerSavePath()
+{
+	if (!EasySettingsLibPrivate::ContainerSavePathOverride.IsEmpty())
+		return EasySettingsLibPrivate::ContainerSavePathOverride;
+
+	FString folder = GetConfigPath();
+	FString name = GetContainerSaveName();
+	return folder / name;
+}
+
+void UEasySettingsLib::SetContainerSavePathOverride(const FString& InPath)
+{
+	EasySettingsLibPrivate::ContainerSavePathOverride = InPath;
+}
+
+FString UEasySettingsLib::GetContainerJournalPath()
+{
+	return GetContainerSavePath() + TEXT(".journal");
+}
+
+FString UEasySettingsLib::GetSettingsProfilePath(FName InName)
+{
+	// Names come from players too, they must not be able to point outside the profiles folder
+	return GetConfigPath() / TEXT("Profiles") / FPaths::MakeValidFileName(InName.ToString()) + TEXT(".profile");
+}
+
 const UEasySettingsSubsystemDeveloperSettings* UEasySettingsLib::GetDeveloperSettings()
 {
 	return GetDefault<UEasySettingsSubsystemDeveloperSettings>();
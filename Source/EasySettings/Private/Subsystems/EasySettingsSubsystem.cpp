@@ -3,9 +3,56 @@
 
 #include "Subsystems/EasySettingsSubsystem.h"
 
+#include "Algo/Unique.h"
+#include "Data/EasySettingsContainerLoader.h"
+#include "Data/EasySettingsContainerWriter.h"
+#include "EasySettings.h"
+#include "EasySettingsStats.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Libs/DataSerializerLib.h"
 #include "Libs/EasySettingsLib.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "Scalability.h"
+
+namespace EasySettingsSubsystemPrivate
+{
+	/** Ratios that resolutions slightly off them (1366x768, 2560x1080) are reported as. */
+	const FIntPoint CommonAspectRatios[] = {{4, 3}, {5, 4}, {3, 2}, {16, 10}, {16, 9}, {21, 9}, {32, 9}};
+
+	FIntPoint GetAspectRatio(FIntPoint InResolution)
+	{
+		if (InResolution.X <= 0 || InResolution.Y <= 0)
+			return FIntPoint::ZeroValue;
+
+		const double ratio = static_cast<double>(InResolution.X) / InResolution.Y;
+		for (const FIntPoint& common : CommonAspectRatios)
+		{
+			if (FMath::Abs(ratio * common.Y / common.X - 1.0) < 0.03)
+				return common;
+		}
+		const int32 divisor = FMath::GreatestCommonDivisor(InResolution.X, InResolution.Y);
+		return FIntPoint(InResolution.X / divisor, InResolution.Y / divisor);
+	}
+
+	/**
+	 * Time the slowest of game thread, render thread and GPU spent on the previous frame, in seconds. Unlike the frame
+	 * delta it does not include waiting for VSync or the frame rate limit.
+	 */
+	float GetFrameWorkTime()
+	{
+		const double gameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+		const double renderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+		const double gpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+		return static_cast<float>(FMath::Max3(gameThreadMs, renderThreadMs, gpuMs) / 1000.0);
+	}
+}
 
 void UEasySettingsSubsystem::SetSettingsQuality(ESettingsType InSettingsType, int32 InQuality, bool bApply)
 {
@@ -49,11 +96,13 @@ int32 UEasySettingsSubsystem::GetSettingsQuality(ESettingsType InSettingsType) c
 
 void UEasySettingsSubsystem::SetAntialiasingMethod(APlayerController* InController, int32 InValue, bool bApply)
 {
-	if (!IsValid(InController))
-		return;
-
 	int32 clamped = FMath::Clamp(InValue, 0, 4);
-	InController->ConsoleCommand(FString::Printf(TEXT("r.AntiAliasingMethod %d"), clamped));
+	if (!AntiAliasingMethodVariable.SetInt(clamped))
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Failed to set the anti-aliasing method to %d, '%s' is missing or set with a higher priority"),
+		       clamped, *AntiAliasingMethodVariable.GetName());
+		return;
+	}
 
 	if (bApply)
 		ApplySettings();
@@ -61,11 +110,7 @@ void UEasySettingsSubsystem::SetAntialiasingMethod(APlayerController* InControll
 
 int32 UEasySettingsSubsystem::GetAntialiasingMethod() const
 {
-	if (IConsoleVariable* antiAliasingMethod = IConsoleManager::Get().FindConsoleVariable(TEXT("r.AntiAliasingMethod")))
-	{
-		return antiAliasingMethod->GetInt();
-	}
-	return 0;
+	return AntiAliasingMethodVariable.GetInt();
 }
 
 void UEasySettingsSubsystem::SetAntialiasingQuality(int32 InValue, bool bApply)
@@ -209,18 +254,128 @@ void UEasySettingsSubsystem::SetResolution(FIntPoint InResolution, bool bApply)
 void UEasySettingsSubsystem::GetSupportedResolutions(TArray<FIntPoint>& OutResult,
                                                      TEnumAsByte<EWindowMode::Type> InWindowMode)
 {
-	if (InWindowMode == EWindowMode::Type::Windowed)
-	{
-		UKismetSystemLibrary::GetConvenientWindowedResolutions(OutResult);
+	OutResult = GetResolutionList(InWindowMode).Resolutions;
+}
+
+TConstArrayView<FIntPoint> UEasySettingsSubsystem::GetSupportedResolutionsView(EWindowMode::Type InWindowMode) const
+{
+	return GetResolutionList(InWindowMode).Resolutions;
+}
+
+TConstArrayView<FIntPoint> UEasySettingsSubsystem::GetSupportedAspectRatiosView(EWindowMode::Type InWindowMode) const
+{
+	return GetResolutionList(InWindowMode).AspectRatios;
+}
+
+void UEasySettingsSubsystem::GetSupportedAspectRatios(TArray<FIntPoint>& OutResult,
+                                                      TEnumAsByte<EWindowMode::Type> InWindowMode) const
+{
+	OutResult = GetResolutionList(InWindowMode).AspectRatios;
+}
+
+void UEasySettingsSubsystem::GetSupportedResolutionsForAspectRatio(TArray<FIntPoint>& OutResult,
+                                                                   FIntPoint InAspectRatio,
+                                                                   TEnumAsByte<EWindowMode::Type> InWindowMode) const
+{
+	OutResult.Reset();
+	const FResolutionList& list = GetResolutionList(InWindowMode);
+	const int32 aspectRatioIndex = list.AspectRatios.IndexOfByKey(InAspectRatio);
+	if (aspectRatioIndex == INDEX_NONE)
 		return;
+
+	for (int32 i = 0; i < list.Resolutions.Num(); ++i)
+	{
+		if (list.AspectRatioIndices[i] == aspectRatioIndex)
+		{
+			OutResult.Add(list.Resolutions[i]);
+		}
+	}
+}
+
+TConstArrayView<uint32> UEasySettingsSubsystem::GetSupportedRefreshRatesView(FIntPoint InResolution) const
+{
+	if (!bRefreshRatesValid)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(EasySettings_QueryRefreshRates);
+		RefreshRates.Reset();
+		FScreenResolutionArray displayModes;
+		if (RHIGetAvailableResolutions(displayModes, false))
+		{
+			for (const FScreenResolutionRHI& displayMode : displayModes)
+			{
+				RefreshRates.FindOrAdd(FIntPoint(displayMode.Width, displayMode.Height)).AddUnique(displayMode.RefreshRate);
+			}
+		}
+		for (TPair<FIntPoint, TArray<uint32>>& pair : RefreshRates)
+		{
+			pair.Value.Sort();
+		}
+		bRefreshRatesValid = true;
+	}
+
+	const TArray<uint32>* rates = RefreshRates.Find(InResolution);
+	return rates ? TConstArrayView<uint32>(*rates) : TConstArrayView<uint32>();
+}
+
+void UEasySettingsSubsystem::GetSupportedRefreshRates(TArray<int32>& OutResult, FIntPoint InResolution) const
+{
+	OutResult.Reset();
+	for (uint32 rate : GetSupportedRefreshRatesView(InResolution))
+	{
+		OutResult.Add(static_cast<int32>(rate));
+	}
+}
+
+void UEasySettingsSubsystem::InvalidateSupportedResolutions()
+{
+	WindowedResolutions.bValid = false;
+	FullscreenResolutions.bValid = false;
+	bRefreshRatesValid = false;
+}
+
+const UEasySettingsSubsystem::FResolutionList& UEasySettingsSubsystem::GetResolutionList(
+	EWindowMode::Type InWindowMode) const
+{
+	// Windowed fullscreen uses the fullscreen list, as it always did
+	FResolutionList& list = InWindowMode == EWindowMode::Windowed ? WindowedResolutions : FullscreenResolutions;
+	if (list.bValid)
+		return list;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(EasySettings_QueryResolutions);
+	list.Resolutions.Reset();
+	if (InWindowMode == EWindowMode::Windowed)
+	{
+		UKismetSystemLibrary::GetConvenientWindowedResolutions(list.Resolutions);
+	}
+	else
+	{
+		UKismetSystemLibrary::GetSupportedFullscreenResolutions(list.Resolutions);
+	}
+	list.Resolutions.Sort([](const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.X != B.X ? A.X < B.X : A.Y < B.Y;
+	});
+	list.Resolutions.SetNum(Algo::Unique(list.Resolutions));
+
+	list.AspectRatios.Reset();
+	list.AspectRatioIndices.Reset(list.Resolutions.Num());
+	for (const FIntPoint& resolution : list.Resolutions)
+	{
+		list.AspectRatioIndices.Add(list.AspectRatios.AddUnique(EasySettingsSubsystemPrivate::GetAspectRatio(resolution)));
 	}
+	list.bValid = true;
+	return list;
+}
 
-	UKismetSystemLibrary::GetSupportedFullscreenResolutions(OutResult);
+void UEasySettingsSubsystem::HandleDisplayMetricsChanged(const FDisplayMetrics& InMetrics)
+{
+	InvalidateSupportedResolutions();
+	OnSupportedResolutionsChanged.Broadcast();
 }
 
 void UEasySettingsSubsystem::SetContainerValue(uint8 InCategory, float InValue, bool bApply)
 {
-	if (!IsValid(SettingsSetter))
+	if (!EnsureContainerLoaded())
 		return;
 	SettingsSetter->SetValue(InCategory, InValue);
 	if (bApply)
@@ -229,83 +384,1669 @@ void UEasySettingsSubsystem::SetContainerValue(uint8 InCategory, float InValue,
 
 bool UEasySettingsSubsystem::GetContainerValue(uint8 InCategory, float& OutValue)
 {
-	if (!IsValid(SettingsSetter))
+	if (!EnsureContainerLoaded())
 		return false;
 	return SettingsSetter->GetValue(InCategory, OutValue);
 }
 
-void UEasySettingsSubsystem::ApplySettings()
+void UEasySettingsSubsystem::SetContainerInt(uint8 InCategory, int32 InValue, bool bApply)
 {
-	GetGameUserSettings()->ApplySettings(true);
-	SaveContainer();
+	if (!EnsureContainerLoaded())
+		return;
+	SettingsSetter->SetIntValue(InCategory, InValue);
+	if (bApply)
+		ApplySettings();
 }
 
-void UEasySettingsSubsystem::SaveContainer()
+bool UEasySettingsSubsystem::GetContainerInt(uint8 InCategory, int32& OutValue)
 {
-	if (!IsValid(SettingsSetter))
+	if (!EnsureContainerLoaded())
+		return false;
+	return SettingsSetter->GetIntValue(InCategory, OutValue);
+}
+
+void UEasySettingsSubsystem::SetContainerBool(uint8 InCategory, bool bInValue, bool bApply)
+{
+	if (!EnsureContainerLoaded())
 		return;
+	SettingsSetter->SetBoolValue(InCategory, bInValue);
+	if (bApply)
+		ApplySettings();
+}
 
-	// Prepare empty byte container
-	TArray<uint8> bytes;
-	FMemoryWriter writer(bytes);
+bool UEasySettingsSubsystem::GetContainerBool(uint8 InCategory, bool& bOutValue)
+{
+	if (!EnsureContainerLoaded())
+		return false;
+	return SettingsSetter->GetBoolValue(InCategory, bOutValue);
+}
 
-	// Write bytes from settings
-	SettingsSetter->Write(writer);
+void UEasySettingsSubsystem::SetContainerVector(uint8 InCategory, FVector4 InValue, bool bApply)
+{
+	if (!EnsureContainerLoaded())
+		return;
+	SettingsSetter->SetVectorValue(InCategory, FVector4f(InValue));
+	if (bApply)
+		ApplySettings();
+}
 
-	// Save to file
-	FString path = GetContainerSavePath();
-	UDataSerializerLib::WriteBytesToDiskCompressed(bytes, path);
+bool UEasySettingsSubsystem::GetContainerVector(uint8 InCategory, FVector4& OutValue)
+{
+	if (!EnsureContainerLoaded())
+		return false;
+	FVector4f value;
+	if (!SettingsSetter->GetVectorValue(InCategory, value))
+		return false;
+	OutValue = FVector4(value);
+	return true;
 }
 
-void UEasySettingsSubsystem::InitContainer()
+int32 UEasySettingsSubsystem::ResolveNamedSetting(FName InName) const
 {
-	// Destroy previous container
-	if (IsValid(SettingsSetter))
+	if (InName.IsNone())
+		return INDEX_NONE;
+	return FEasySettingsKeyRegistry::Get().Resolve(InName.ToString());
+}
+
+void UEasySettingsSubsystem::SetNamedValueBySlot(int32 InSlot, float InValue, bool bApply)
+{
+	if (!EnsureContainerLoaded())
+		return;
+	SettingsSetter->SetNamedValue(InSlot, InValue);
+	if (bApply)
+		ApplySettings();
+}
+
+bool UEasySettingsSubsystem::GetNamedValueBySlot(int32 InSlot, float& OutValue)
+{
+	if (!EnsureContainerLoaded())
+		return false;
+	return SettingsSetter->GetNamedValue(InSlot, OutValue);
+}
+
+int32 UEasySettingsSubsystem::GetContainerValues(TArrayView<const uint8> InCategories, TArrayView<float> OutValues)
+{
+	if (!EnsureContainerLoaded())
+		return 0;
+	return SettingsSetter->GetValues(InCategories, OutValues);
+}
+
+void UEasySettingsSubsystem::SetContainerValues(TArrayView<const uint8> InCategories, TArrayView<const float> InValues,
+                                                bool bApply)
+{
+	if (!EnsureContainerLoaded())
+		return;
+	SettingsSetter->SetValues(InCategories, InValues);
+	if (bApply)
+		ApplySettings();
+}
+
+const EasySettings::FContainer* UEasySettingsSubsystem::GetContainerStorage()
+{
+	if (!EnsureContainerLoaded())
+		return nullptr;
+	return &SettingsSetter->GetValues();
+}
+
+TSharedRef<const FEasySettingsSharedValues, ESPMode::ThreadSafe> UEasySettingsSubsystem::GetSharedContainerValues() const
+{
+	return SharedContainerValues.ToSharedRef();
+}
+
+TConstArrayView<float> UEasySettingsSubsystem::GetAllContainerValues()
+{
+	if (!EnsureContainerLoaded())
+		return TConstArrayView<float>();
+	return SettingsSetter->GetValuesView();
+}
+
+bool UEasySettingsSubsystem::GetContainerValuesArray(const TArray<uint8>& InCategories, TArray<float>& OutValues)
+{
+	OutValues.SetNumZeroed(InCategories.Num());
+	return GetContainerValues(InCategories, OutValues) == InCategories.Num();
+}
+
+void UEasySettingsSubsystem::SetContainerValuesArray(const TArray<uint8>& InCategories, const TArray<float>& InValues,
+                                                     bool bApply)
+{
+	if (!ensureMsgf(InCategories.Num() == InValues.Num(), TEXT("Categories and values must have the same length")))
+		return;
+	SetContainerValues(InCategories, InValues, bApply);
+}
+
+void UEasySettingsSubsystem::GetAllContainerValuesArray(TArray<float>& OutValues)
+{
+	TConstArrayView<float> values = GetAllContainerValues();
+	OutValues.Reset(values.Num());
+	OutValues.Append(values.GetData(), values.Num());
+}
+
+float UEasySettingsSubsystem::GetConsoleVariableSetting(int32 InIndex) const
+{
+	if (!ConsoleVariableRegistry.IsValidIndex(InIndex))
+		return 0.0f;
+	return ConsoleVariableRegistry.GetValue(InIndex);
+}
+
+void UEasySettingsSubsystem::SetConsoleVariableSetting(int32 InIndex, float InValue, bool bApply)
+{
+	if (!ConsoleVariableRegistry.IsValidIndex(InIndex))
+		return;
+
+	const float value = ConsoleVariableRegistry.Sanitize(InIndex, InValue);
+	const FEasySettingsConsoleVariableEntry& entry = ConsoleVariableRegistry.GetEntry(InIndex);
+	if (!ConsoleVariableRegistry.SetValue(InIndex, value))
 	{
-		SettingsSetter->ConditionalBeginDestroy();
-		SettingsSetter = nullptr;
+		UE_LOG(LogEasySettings, Warning, TEXT("Console variable '%s' of setting '%s' is not registered or set with a higher priority"),
+		       *entry.ConsoleVariable, *entry.Name.ToString());
 	}
-	// Create setter based on class from settings
-	TSubclassOf<UEasySettingsSetter> settingsSetterClass = UEasySettingsLib::GetSettingsSetterClass();
-	SettingsSetter = NewObject<UEasySettingsSetter>(this, settingsSetterClass);
 
-	// Try to read container from disk
-	FString path = GetContainerSavePath();
-	// File must exist
-	if (FPaths::FileExists(path))
+	if (entry.bPersist)
+	{
+		SetContainerValue(entry.ContainerKey, value, bApply);
+	}
+	else if (bApply)
+	{
+		ApplySettings();
+	}
+}
+
+bool UEasySettingsSubsystem::GetConsoleVariableSettingByName(FName InName, float& OutValue) const
+{
+	const int32 index = ConsoleVariableRegistry.FindIndex(InName);
+	if (index == INDEX_NONE)
+		return false;
+	OutValue = ConsoleVariableRegistry.GetValue(index);
+	return true;
+}
+
+bool UEasySettingsSubsystem::SetConsoleVariableSettingByName(FName InName, float InValue, bool bApply)
+{
+	const int32 index = ConsoleVariableRegistry.FindIndex(InName);
+	if (index == INDEX_NONE)
+		return false;
+	SetConsoleVariableSetting(index, InValue, bApply);
+	return true;
+}
+
+int32 UEasySettingsSubsystem::SeedContainerDefaults()
+{
+	// A key added in an update is still zero in existing containers, it gets its default instead
+	int32 seeded = 0;
+	for (uint8 key : ValueSchema.GetKeys())
+	{
+		if (SettingsSetter->IsKeyWritten(key))
+			continue;
+		SettingsSetter->SetValue(key, ValueSchema.GetDefault(key));
+		++seeded;
+	}
+	for (int32 i = 0; i < ConsoleVariableRegistry.Num(); ++i)
+	{
+		const FEasySettingsConsoleVariableEntry& entry = ConsoleVariableRegistry.GetEntry(i);
+		if (!entry.bPersist || SettingsSetter->IsKeyWritten(entry.ContainerKey))
+			continue;
+		SettingsSetter->SetValue(entry.ContainerKey, ConsoleVariableRegistry.Sanitize(i, entry.Default));
+		++seeded;
+	}
+	return seeded;
+}
+
+void UEasySettingsSubsystem::RestoreConsoleVariableSettings()
+{
+	const EasySettings::FContainer& values = SettingsSetter->GetValues();
+	for (int32 i = 0; i < ConsoleVariableRegistry.Num(); ++i)
 	{
-		// Read bytes from disk
-		TArray<uint8> fileBytes;
-		if (UDataSerializerLib::ReadCompressedBytesFromDisk(fileBytes, path))
+		const FEasySettingsConsoleVariableEntry& entry = ConsoleVariableRegistry.GetEntry(i);
+		if (!entry.bPersist)
+			continue;
+
+		if (const float* value = values.Find(entry.ContainerKey))
 		{
-			// Fill settings data
-			FMemoryReader reader(fileBytes);
-			SettingsSetter->Read(reader);
+			ConsoleVariableRegistry.SetValue(i, *value);
 		}
 	}
-	else
+}
+
+FEasySettingsProfile UEasySettingsSubsystem::CaptureSettingsProfile(FName InName, bool bIncludeContainer)
+{
+	FEasySettingsProfile profile;
+	profile.Name = InName;
+	profile.EngineState = FEasySettingsEngineState::Capture(GetGameUserSettings());
+	if (bIncludeContainer && EnsureContainerLoaded())
 	{
-		SettingsSetter->InitializeEmpty();
-		// Save to disk again (create file if not created)
-		SaveContainer();
+		TConstArrayView<float> values = SettingsSetter->GetValuesView();
+		profile.ContainerValues.Append(values.GetData(), values.Num());
+
+		const EasySettings::FContainer& container = SettingsSetter->GetValues();
+		const EasySettings::FTypedLayout& layout = *container.Layout;
+		for (int32 slot = 0; slot < layout.IntKeys.Num(); ++slot)
+		{
+			profile.ContainerInts.Add(layout.IntKeys[slot], container.Ints[slot]);
+		}
+		for (int32 slot = 0; slot < layout.BoolKeys.Num(); ++slot)
+		{
+			profile.ContainerBools.Add(layout.BoolKeys[slot], container.Bools[slot]);
+		}
+		for (int32 slot = 0; slot < layout.VectorKeys.Num(); ++slot)
+		{
+			profile.ContainerVectors.Add(layout.VectorKeys[slot], FVector4(container.Vectors[slot]));
+		}
+
+		const TArray<float>& namedValues = SettingsSetter->GetNamedValues();
+		const FEasySettingsKeyRegistry& registry = FEasySettingsKeyRegistry::Get();
+		for (int32 slot = 0; slot < namedValues.Num(); ++slot)
+		{
+			profile.NamedValues.Add(registry.GetName(slot), namedValues[slot]);
+		}
 	}
+	return profile;
 }
 
-FString UEasySettingsSubsystem::GetContainerSavePath()
+int32 UEasySettingsSubsystem::ApplySettingsProfile(const FEasySettingsProfile& InProfile)
 {
-	FString folder = UEasySettingsLib::GetConfigPath();
-	FString name = UEasySettingsLib::GetContainerSaveName();
-	FString path = folder / name;
-	return path;
+	FEasySettingsBatchScope batch(this);
+
+	UGameUserSettings* settings = GetGameUserSettings();
+	check(IsValid(settings));
+	int32 changed = InProfile.EngineState.RestoreChanged(settings, FEasySettingsEngineState::Capture(settings));
+
+	if (InProfile.ContainerValues.Num() > 0 && EnsureContainerLoaded())
+	{
+		// Only hand the differing values to the setter
+		TConstArrayView<float> currentValues = SettingsSetter->GetValuesView();
+		const int32 n = FMath::Min(InProfile.ContainerValues.Num(), currentValues.Num());
+		TArray<uint8, TInlineAllocator<32>> categories;
+		TArray<float, TInlineAllocator<32>> values;
+		for (int32 i = 0; i < n; ++i)
+		{
+			if (currentValues[i] != InProfile.ContainerValues[i])
+			{
+				categories.Add(static_cast<uint8>(i));
+				values.Add(InProfile.ContainerValues[i]);
+			}
+		}
+		SettingsSetter->SetValues(categories, values);
+		changed += categories.Num();
+	}
+
+	if (EnsureContainerLoaded())
+	{
+		// Typed and named values are diffed the same way, categories this build does not declare are skipped
+		for (const TPair<uint8, int32>& pair : InProfile.ContainerInts)
+		{
+			int32 current;
+			if (SettingsSetter->GetIntValue(pair.Key, current) && current != pair.Value)
+			{
+				SettingsSetter->SetIntValue(pair.Key, pair.Value);
+				++changed;
+			}
+		}
+		for (const TPair<uint8, bool>& pair : InProfile.ContainerBools)
+		{
+			bool bCurrent;
+			if (SettingsSetter->GetBoolValue(pair.Key, bCurrent) && bCurrent != pair.Value)
+			{
+				SettingsSetter->SetBoolValue(pair.Key, pair.Value);
+				++changed;
+			}
+		}
+		for (const TPair<uint8, FVector4>& pair : InProfile.ContainerVectors)
+		{
+			FVector4f current;
+			if (SettingsSetter->GetVectorValue(pair.Key, current) && current != FVector4f(pair.Value))
+			{
+				SettingsSetter->SetVectorValue(pair.Key, FVector4f(pair.Value));
+				++changed;
+			}
+		}
+		FEasySettingsKeyRegistry& registry = FEasySettingsKeyRegistry::Get();
+		for (const TPair<FString, float>& pair : InProfile.NamedValues)
+		{
+			const int32 slot = registry.Resolve(pair.Key);
+			float current;
+			if (slot != INDEX_NONE && SettingsSetter->GetNamedValue(slot, current) && current != pair.Value)
+			{
+				SettingsSetter->SetNamedValue(slot, pair.Value);
+				++changed;
+			}
+		}
+	}
+
+	if (changed > 0)
+	{
+		ApplySettings();
+	}
+	return changed;
 }
 
-void UEasySettingsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+bool UEasySettingsSubsystem::SaveSettingsProfile(const FEasySettingsProfile& InProfile)
 {
-	InitContainer();
+	if (InProfile.Name.IsNone())
+		return false;
+
+	TArray<uint8> bytes;
+	FMemoryWriter writer(bytes);
+	InProfile.Write(writer);
+	return FEasySettingsContainerWriter::WriteSnapshot(bytes, UEasySettingsLib::GetSettingsProfilePath(InProfile.Name));
 }
 
-void UEasySettingsSubsystem::Deinitialize()
+bool UEasySettingsSubsystem::LoadSettingsProfile(FName InName, FEasySettingsProfile& OutProfile)
+{
+	FString path = UEasySettingsLib::GetSettingsProfilePath(InName);
+	TArray<uint8> bytes;
+	if (!FPaths::FileExists(path) || !UDataSerializerLib::ReadCompressedBytesFromDisk(bytes, path))
+		return false;
+
+	FMemoryReader reader(bytes);
+	if (!OutProfile.Read(reader))
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Settings profile '%s' is corrupted or unsupported"), *path);
+		return false;
+	}
+	return true;
+}
+
+bool UEasySettingsSubsystem::RunHardwareBenchmark(bool bApply)
+{
+	FEasySettingsHardwareBenchmark result;
+	if (!FEasySettingsHardwareBenchmark::Run(UEasySettingsLib::GetDeveloperSettings()->AutoDetectWorkScale, result))
+		return false;
+
+	result.SaveCached(FEasySettingsHardwareBenchmark::ComputeFingerprint());
+	if (bApply)
+	{
+		ApplyHardwareBenchmark(result);
+	}
+	OnHardwareBenchmarkFinished.Broadcast(result, bApply);
+	return true;
+}
+
+bool UEasySettingsSubsystem::GetCachedHardwareBenchmark(FEasySettingsHardwareBenchmark& OutResult) const
+{
+	FString fingerprint;
+	return FEasySettingsHardwareBenchmark::LoadCached(fingerprint, OutResult)
+		&& fingerprint == FEasySettingsHardwareBenchmark::ComputeFingerprint();
+}
+
+void UEasySettingsSubsystem::ApplyHardwareBenchmark(const FEasySettingsHardwareBenchmark& InResult)
 {
+	FEasySettingsBatchScope batch(this);
+	SetAntialiasingQuality(InResult.AntiAliasingQuality, false);
+	SetTextureQuality(InResult.TextureQuality, false);
+	SetEffectsQuality(InResult.EffectsQuality, false);
+	SetDetailsQuality(InResult.DetailsQuality, false);
+	SetShadowsQuality(InResult.ShadowsQuality, false);
+	if (InResult.Resolution != FIntPoint::ZeroValue)
+	{
+		SetResolution(InResult.Resolution, false);
+	}
+	SetFrameRateLimit(InResult.FrameRateLimit, false);
 	ApplySettings();
-	Super::Deinitialize();
+}
+
+bool UEasySettingsSubsystem::PollAutoDetect(float InDeltaTime)
+{
+	if (GFrameCounter < AutoDetectFrame)
+		return true;
+	AutoDetectTickerHandle.Reset();
+
+	// First launch is only known once the container has been read
+	EnsureContainerLoaded();
+
+	FString cachedFingerprint;
+	FEasySettingsHardwareBenchmark cached;
+	const bool bHasCache = FEasySettingsHardwareBenchmark::LoadCached(cachedFingerprint, cached);
+	if (bHasCache && cachedFingerprint == FEasySettingsHardwareBenchmark::ComputeFingerprint())
+	{
+		if (bContainerCreated)
+		{
+			ApplyHardwareBenchmark(cached);
+			OnHardwareBenchmarkFinished.Broadcast(cached, true);
+		}
+		return false;
+	}
+
+	// Only a first launch is applied. After a hardware or driver change the player keeps their choices, the game
+	// decides from the broadcast whether to offer the new result through `ApplyHardwareBenchmark`.
+	UE_LOG(LogEasySettings, Log, TEXT("Running hardware benchmark (%s)"),
+	       bHasCache ? TEXT("hardware changed") : TEXT("no cached result"));
+	RunHardwareBenchmark(bContainerCreated);
+	return false;
+}
+
+bool UEasySettingsSubsystem::StartSettingsCostProfile()
+{
+	if (IsSettingsCostProfileRunning())
+		return false;
+
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	CostProfileGroups.Reset();
+	for (ESettingsType settingsType : developerSettings->CostProfileGroups)
+	{
+		if (settingsType != ESettingsType::TYPE_NONE && settingsType < ESettingsType::TYPE_MAX)
+		{
+			CostProfileGroups.AddUnique(settingsType);
+		}
+	}
+	if (CostProfileGroups.Num() == 0)
+	{
+		UE_LOG(LogEasySettings, Warning, TEXT("Settings cost profile has no groups to measure"));
+		return false;
+	}
+
+	const TSoftObjectPtr<UWorld>& map = developerSettings->CostProfileMap;
+	const UWorld* world = GetWorld();
+	if (map.IsNull() || (world && world->GetPackage()->GetName() == map.GetLongPackageName()))
+	{
+		BeginCostProfileSweep();
+		return true;
+	}
+
+	CostProfileMapLoadedHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
+		this, &UEasySettingsSubsystem::HandleCostProfileMapLoaded);
+	// Without a world yet, the startup map may be the configured one
+	bCostProfileMapOpened = world != nullptr;
+	if (bCostProfileMapOpened)
+	{
+		UE_LOG(LogEasySettings, Log, TEXT("Settings cost profile: opening %s"), *map.GetLongPackageName());
+		UGameplayStatics::OpenLevelBySoftObjectPtr(this, map);
+	}
+	return true;
+}
+
+void UEasySettingsSubsystem::CancelSettingsCostProfile()
+{
+	if (IsSettingsCostProfileRunning())
+	{
+		FinishCostProfile(false);
+	}
+}
+
+void UEasySettingsSubsystem::HandleCostProfileMapLoaded(UWorld* InWorld)
+{
+	const TSoftObjectPtr<UWorld>& map = UEasySettingsLib::GetDeveloperSettings()->CostProfileMap;
+	if (!InWorld)
+		return;
+	if (InWorld->GetPackage()->GetName() != map.GetLongPackageName())
+	{
+		// The startup map was not the configured one, travel once
+		if (!bCostProfileMapOpened)
+		{
+			bCostProfileMapOpened = true;
+			UE_LOG(LogEasySettings, Log, TEXT("Settings cost profile: opening %s"), *map.GetLongPackageName());
+			UGameplayStatics::OpenLevelBySoftObjectPtr(InWorld, map);
+		}
+		return;
+	}
+
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(CostProfileMapLoadedHandle);
+	CostProfileMapLoadedHandle.Reset();
+	BeginCostProfileSweep();
+}
+
+void UEasySettingsSubsystem::BeginCostProfileSweep()
+{
+	// Measured against what the user picked, never against governed qualities
+	bCostProfileGovernorWasEnabled = IsQualityGovernorEnabled();
+	SetQualityGovernorEnabled(false);
+	CostProfileUserState = FEasySettingsEngineState::Capture(GetGameUserSettings());
+	CostProfileSamples.Reset();
+	CostProfileQuality = -1;
+	SuspendFrameRateLimits();
+
+	UE_LOG(LogEasySettings, Log, TEXT("Settings cost profile started (%d groups)"), CostProfileGroups.Num());
+	AdvanceCostProfile();
+	CostProfileTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UEasySettingsSubsystem::TickCostProfile));
+}
+
+bool UEasySettingsSubsystem::TickCostProfile(float InDeltaTime)
+{
+	if (IsSettingsBatchActive())
+		return true;
+
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	CostProfileStepTime += InDeltaTime;
+	const float sampleTime = CostProfileStepTime - developerSettings->CostProfileWarmupSeconds;
+	if (sampleTime <= 0.0f)
+		return true;
+
+	// Thread times are those of the previous frame, close enough over a window of several seconds
+	FEasySettingsCostSample& sum = CostProfileAccumulator;
+	const float frameTimeMs = InDeltaTime * 1000.0f;
+	const float gameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	const float renderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	const float gpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+	++sum.Frames;
+	sum.FrameTimeMs += frameTimeMs;
+	sum.MaxFrameTimeMs = FMath::Max(sum.MaxFrameTimeMs, frameTimeMs);
+	sum.GameThreadMs += gameThreadMs;
+	sum.RenderThreadMs += renderThreadMs;
+	sum.GPUMs += gpuMs;
+	sum.BottleneckMs += FMath::Max3(gameThreadMs, renderThreadMs, gpuMs);
+	if (sampleTime < FMath::Max(developerSettings->CostProfileSampleSeconds, 0.1f))
+		return true;
+
+	FEasySettingsCostSample& sample = CostProfileSamples.Add_GetRef(sum);
+	sample.FrameTimeMs /= sample.Frames;
+	sample.GameThreadMs /= sample.Frames;
+	sample.RenderThreadMs /= sample.Frames;
+	sample.GPUMs /= sample.Frames;
+	sample.BottleneckMs /= sample.Frames;
+	UE_LOG(LogEasySettings, Log, TEXT("Settings cost profile: %s %d - frame %.2f ms (max %.2f), game %.2f ms, "
+		       "render %.2f ms, GPU %.2f ms, bottleneck %.2f ms over %d frames"),
+	       *UEnum::GetValueAsString(sample.SettingsType), sample.Quality, sample.FrameTimeMs, sample.MaxFrameTimeMs,
+	       sample.GameThreadMs, sample.RenderThreadMs, sample.GPUMs, sample.BottleneckMs, sample.Frames);
+
+	if (AdvanceCostProfile())
+		return true;
+
+	CostProfileTickerHandle.Reset();
+	FinishCostProfile(true);
+	return false;
+}
+
+bool UEasySettingsSubsystem::AdvanceCostProfile()
+{
+	const int32 maxQuality = FMath::Clamp(UEasySettingsLib::GetDeveloperSettings()->CostProfileMaxQuality, 0, 4);
+	if (++CostProfileQuality > maxQuality)
+	{
+		// Back to the user choice before the next group is measured
+		CostProfileUserState.RestoreGroup(CostProfileGroups[0], GetGameUserSettings());
+		CostProfileGroups.RemoveAt(0);
+		CostProfileQuality = 0;
+		if (CostProfileGroups.Num() == 0)
+		{
+			ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+			return false;
+		}
+	}
+
+	const ESettingsType settingsType = CostProfileGroups[0];
+	SetSettingsQuality(settingsType, CostProfileQuality, false);
+	ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+
+	CostProfileStepTime = 0.0f;
+	CostProfileAccumulator = FEasySettingsCostSample();
+	CostProfileAccumulator.SettingsType = settingsType;
+	CostProfileAccumulator.Quality = CostProfileQuality;
+	return true;
+}
+
+void UEasySettingsSubsystem::FinishCostProfile(bool bCompleted)
+{
+	if (CostProfileMapLoadedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(CostProfileMapLoadedHandle);
+		CostProfileMapLoadedHandle.Reset();
+	}
+	const bool bSweepStarted = bCompleted || CostProfileTickerHandle.IsValid();
+	if (CostProfileTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CostProfileTickerHandle);
+		CostProfileTickerHandle.Reset();
+		// Cancelled mid-sweep, the current group still holds a measured level
+		CostProfileUserState.RestoreGroup(CostProfileGroups[0], GetGameUserSettings());
+		ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+	}
+	if (bSweepStarted)
+	{
+		// Back to the user VSync and frame rate limit
+		ApplyEngineChanges(EEasySettingsEngineChange::VSync | EEasySettingsEngineChange::FrameRate);
+	}
+	CostProfileGroups.Reset();
+	if (bCostProfileGovernorWasEnabled)
+	{
+		bCostProfileGovernorWasEnabled = false;
+		SetQualityGovernorEnabled(true);
+	}
+
+	if (bCompleted)
+	{
+		const FString basePath = FPaths::ProfilingDir() / TEXT("EasySettings") /
+			FString::Printf(TEXT("CostProfile-%s"), *FDateTime::Now().ToString());
+		FEasySettingsCostSample::WriteCsv(CostProfileSamples, basePath + TEXT(".csv"));
+		FEasySettingsCostSample::WriteJson(CostProfileSamples, basePath + TEXT(".json"));
+
+		FString stepOrder;
+		for (ESettingsType settingsType : FEasySettingsCostSample::SortGroupsByCost(CostProfileSamples))
+		{
+			stepOrder += (stepOrder.IsEmpty() ? TEXT("") : TEXT(", ")) + UEnum::GetValueAsString(settingsType);
+		}
+		UE_LOG(LogEasySettings, Log, TEXT("Settings cost profile written to %s.csv, most expensive groups first: %s"),
+		       *basePath, *stepOrder);
+		OnSettingsCostProfileFinished.Broadcast(CostProfileSamples);
+	}
+	else
+	{
+		UE_LOG(LogEasySettings, Log, TEXT("Settings cost profile cancelled"));
+	}
+
+	if (bQuitAfterCostProfile)
+	{
+		bQuitAfterCostProfile = false;
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+bool UEasySettingsSubsystem::RestoreCostProfileLevel()
+{
+	if (!CostProfileTickerHandle.IsValid() || CostProfileGroups.Num() == 0)
+		return false;
+
+	UGameUserSettings* settings = GetGameUserSettings();
+	const ESettingsType settingsType = CostProfileGroups[0];
+	if (GetSettingsQuality(settingsType) == CostProfileQuality)
+	{
+		CostProfileUserState.RestoreGroup(settingsType, settings);
+	}
+	// Whatever the user changed during the sweep is the new choice to restore once it ends
+	CostProfileUserState = FEasySettingsEngineState::Capture(settings);
+	return true;
+}
+
+void UEasySettingsSubsystem::ReapplyCostProfileLevel(EEasySettingsEngineChange InChanges)
+{
+	SetSettingsQuality(CostProfileGroups[0], CostProfileQuality, false);
+	if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::Scalability | EEasySettingsEngineChange::Audio))
+	{
+		ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+	}
+	if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::VSync | EEasySettingsEngineChange::FrameRate))
+	{
+		SuspendFrameRateLimits();
+	}
+}
+
+void UEasySettingsSubsystem::SuspendFrameRateLimits()
+{
+	// Capped frames would measure every level below the cap the same
+	VSyncVariable.SetBool(false, ECVF_SetByGameSetting);
+	GEngine->SetMaxFPS(0.0f);
+}
+
+void UEasySettingsSubsystem::ApplySettings()
+{
+	// Defer until the outermost batch is committed
+	if (IsSettingsBatchActive())
+	{
+		bBatchApplyRequested = true;
+		return;
+	}
+
+	EASYSETTINGS_PHASE_SCOPE(ApplySettings);
+	UGameUserSettings* settings = GetGameUserSettings();
+	check(IsValid(settings));
+
+	// Governed qualities and the level measured by the cost profile are temporary, only the user choices are applied
+	// and saved
+	const bool bGoverned = GovernorSteps.Num() > 0;
+	if (bGoverned)
+	{
+		RestoreGovernedQualities();
+	}
+	const bool bProfiling = RestoreCostProfileLevel();
+
+	FEasySettingsEngineState currentState = FEasySettingsEngineState::Capture(settings);
+	EEasySettingsEngineChange changes = currentState.Diff(AppliedEngineState);
+	if (EnumHasAnyFlags(changes, EEasySettingsEngineChange::Display))
+	{
+		// There are no narrow engine calls for the resolution scale, dynamic resolution and HDR. The full apply also
+		// saves, and keeps honoring resolution overrides from the command line
+		{
+			EASYSETTINGS_PHASE_SCOPE(EngineApply);
+			settings->ApplySettings(true);
+		}
+		changes = EEasySettingsEngineChange::Window | EEasySettingsEngineChange::Scalability |
+			EEasySettingsEngineChange::VSync | EEasySettingsEngineChange::FrameRate | EEasySettingsEngineChange::Audio |
+			EEasySettingsEngineChange::Display;
+		// The engine validates the settings during the full apply, keep what it ended up with
+		AppliedEngineState = FEasySettingsEngineState::Capture(settings);
+	}
+	else if (changes != EEasySettingsEngineChange::None)
+	{
+		ApplyEngineChanges(changes);
+		{
+			EASYSETTINGS_PHASE_SCOPE(EngineSave);
+			settings->SaveSettings();
+		}
+		AppliedEngineState = currentState;
+	}
+
+	if (bGoverned)
+	{
+		ReapplyGovernedQualities(EnumHasAnyFlags(changes,
+		                                         EEasySettingsEngineChange::Scalability | EEasySettingsEngineChange::Audio));
+	}
+	if (bProfiling)
+	{
+		ReapplyCostProfileLevel(changes);
+	}
+
+	if (IsContainerDirty())
+	{
+		SaveContainer();
+	}
+}
+
+void UEasySettingsSubsystem::ApplyEngineChanges(EEasySettingsEngineChange InChanges)
+{
+	EASYSETTINGS_PHASE_SCOPE(EngineApply);
+	UGameUserSettings* settings = GetGameUserSettings();
+	check(IsValid(settings));
+
+	if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::Audio))
+	{
+		// There is no narrower call for the audio quality, this one covers every non-resolution category
+		settings->ApplyNonResolutionSettings();
+	}
+	else
+	{
+		if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::Scalability))
+		{
+			const FEasySettingsEngineState state = FEasySettingsEngineState::Capture(settings);
+			Scalability::FQualityLevels levels = Scalability::GetQualityLevels();
+			levels.AntiAliasingQuality = state.AntiAliasingQuality;
+			levels.TextureQuality = state.TextureQuality;
+			levels.EffectsQuality = state.VisualEffectQuality;
+			levels.PostProcessQuality = state.PostProcessingQuality;
+			levels.ShadingQuality = state.ShadingQuality;
+			levels.FoliageQuality = state.FoliageQuality;
+			levels.ReflectionQuality = state.ReflectionQuality;
+			levels.GlobalIlluminationQuality = state.GlobalIlluminationQuality;
+			levels.ViewDistanceQuality = state.ViewDistanceQuality;
+			levels.ShadowQuality = state.ShadowQuality;
+			Scalability::SetQualityLevels(levels);
+		}
+		if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::VSync))
+		{
+			// Same priority as the full engine apply, so both paths can overwrite each other
+			VSyncVariable.SetBool(settings->IsVSyncEnabled(), ECVF_SetByGameSetting);
+		}
+		if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::FrameRate))
+		{
+			GEngine->SetMaxFPS(settings->GetEffectiveFrameRateLimit());
+		}
+	}
+
+	// Changing the resolution or window mode may recreate the swap chain, never do it needlessly
+	if (EnumHasAnyFlags(InChanges, EEasySettingsEngineChange::Window))
+	{
+		EASYSETTINGS_PHASE_SCOPE(ApplyResolution);
+		settings->ApplyResolutionSettings(true);
+	}
+}
+
+void UEasySettingsSubsystem::SetQualityGovernorEnabled(bool bInEnabled)
+{
+	if (bInEnabled == IsQualityGovernorEnabled())
+		return;
+
+	if (bInEnabled)
+	{
+		GovernorFrameTime = 0.0f;
+		GovernorOverBudgetTime = 0.0f;
+		GovernorHeadroomTime = 0.0f;
+		GovernorTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UEasySettingsSubsystem::TickQualityGovernor));
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(GovernorTickerHandle);
+	GovernorTickerHandle.Reset();
+	if (GovernorSteps.Num() > 0)
+	{
+		RestoreGovernedQualities();
+		GovernorSteps.Reset();
+		ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+		UE_LOG(LogEasySettings, Log, TEXT("Quality governor stopped, user settings restored"));
+	}
+}
+
+bool UEasySettingsSubsystem::TickQualityGovernor(float InDeltaTime)
+{
+	if (IsSettingsBatchActive())
+		return true;
+
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	float budget = 1.0f / FMath::Max(developerSettings->GovernorTargetFrameRate, 1.0f);
+
+	// A frame cannot be faster than the frame rate limit or the display with VSync, there is no point in lowering
+	// the quality to reach a target above those
+	float frameRateLimit = GEngine->GetMaxFPS();
+	if (GetGameUserSettings()->IsVSyncEnabled() && FPlatformMisc::GetMaxRefreshRate() > 0)
+	{
+		const float refreshRate = FPlatformMisc::GetMaxRefreshRate();
+		frameRateLimit = frameRateLimit > 0.0f ? FMath::Min(frameRateLimit, refreshRate) : refreshRate;
+	}
+	if (frameRateLimit > 0.0f)
+	{
+		budget = FMath::Max(budget, 1.0f / frameRateLimit);
+	}
+
+	// The frame delta includes the time spent waiting for VSync or the limiter, which would never leave headroom to
+	// step back up. Sample the work time of the bottleneck instead, smoothed and clamped so a single hitch (loading,
+	// garbage collection) does not count as a trend
+	const float sample = FMath::Min(EasySettingsSubsystemPrivate::GetFrameWorkTime(), budget * 4.0f);
+	GovernorFrameTime = GovernorFrameTime > 0.0f ? FMath::Lerp(GovernorFrameTime, sample, 0.1f) : sample;
+
+	if (GovernorFrameTime > budget * developerSettings->GovernorOverBudgetRatio)
+	{
+		GovernorOverBudgetTime += InDeltaTime;
+		GovernorHeadroomTime = 0.0f;
+	}
+	else if (GovernorSteps.Num() > 0 && GovernorFrameTime < budget * developerSettings->GovernorHeadroomRatio)
+	{
+		GovernorHeadroomTime += InDeltaTime;
+		GovernorOverBudgetTime = 0.0f;
+	}
+	else
+	{
+		GovernorOverBudgetTime = 0.0f;
+		GovernorHeadroomTime = 0.0f;
+	}
+
+	if (GovernorOverBudgetTime >= developerSettings->GovernorStepDownSeconds)
+	{
+		GovernorOverBudgetTime = 0.0f;
+		StepQualityDown();
+	}
+	else if (GovernorHeadroomTime >= developerSettings->GovernorStepUpSeconds)
+	{
+		GovernorHeadroomTime = 0.0f;
+		StepQualityUp();
+	}
+	return true;
+}
+
+bool UEasySettingsSubsystem::StepQualityDown()
+{
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	for (ESettingsType settingsType : developerSettings->GovernorStepOrder)
+	{
+		if (settingsType == ESettingsType::TYPE_NONE || settingsType >= ESettingsType::TYPE_MAX)
+			continue;
+		const int32 quality = GetSettingsQuality(settingsType);
+		if (quality <= developerSettings->GovernorMinQuality)
+			continue;
+
+		if (GovernorSteps.Num() == 0)
+		{
+			GovernorUserState = FEasySettingsEngineState::Capture(GetGameUserSettings());
+		}
+		SetSettingsQuality(settingsType, quality - 1, false);
+		GovernorQualities[static_cast<int32>(settingsType)] = quality - 1;
+		GovernorSteps.Add(settingsType);
+		ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+
+		const float frameTimeMs = GovernorFrameTime * 1000.0f;
+		UE_LOG(LogEasySettings, Log, TEXT("Quality governor: %s lowered to %d (frame time %.2f ms)"),
+		       *UEnum::GetValueAsString(settingsType), quality - 1, frameTimeMs);
+		OnQualityGoverned.Broadcast(settingsType, quality - 1, frameTimeMs);
+		return true;
+	}
+	return false;
+}
+
+bool UEasySettingsSubsystem::StepQualityUp()
+{
+	if (GovernorSteps.Num() == 0)
+		return false;
+
+	const ESettingsType settingsType = GovernorSteps.Pop();
+	int32 quality;
+	if (GovernorSteps.Contains(settingsType))
+	{
+		quality = GovernorQualities[static_cast<int32>(settingsType)] + 1;
+		SetSettingsQuality(settingsType, quality, false);
+		GovernorQualities[static_cast<int32>(settingsType)] = quality;
+	}
+	else
+	{
+		// Last step of the group, back to exactly what the user picked
+		GovernorUserState.RestoreGroup(settingsType, GetGameUserSettings());
+		quality = GovernorUserState.GetGroupQuality(settingsType);
+	}
+	ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+
+	const float frameTimeMs = GovernorFrameTime * 1000.0f;
+	UE_LOG(LogEasySettings, Log, TEXT("Quality governor: %s raised to %d (frame time %.2f ms)"),
+	       *UEnum::GetValueAsString(settingsType), quality, frameTimeMs);
+	OnQualityGoverned.Broadcast(settingsType, quality, frameTimeMs);
+	return true;
+}
+
+void UEasySettingsSubsystem::RestoreGovernedQualities()
+{
+	UGameUserSettings* settings = GetGameUserSettings();
+	for (int32 i = static_cast<int32>(ESettingsType::TYPE_AA); i < static_cast<int32>(ESettingsType::TYPE_MAX); ++i)
+	{
+		const ESettingsType settingsType = static_cast<ESettingsType>(i);
+		if (!GovernorSteps.Contains(settingsType))
+			continue;
+
+		if (GetSettingsQuality(settingsType) == GovernorQualities[i])
+		{
+			GovernorUserState.RestoreGroup(settingsType, settings);
+		}
+		else
+		{
+			// The user picked a new quality in the meantime, it wins over the governor
+			GovernorSteps.Remove(settingsType);
+		}
+	}
+}
+
+void UEasySettingsSubsystem::ReapplyGovernedQualities(bool bApplyEngine)
+{
+	if (GovernorSteps.Num() == 0)
+		return;
+
+	for (int32 i = static_cast<int32>(ESettingsType::TYPE_AA); i < static_cast<int32>(ESettingsType::TYPE_MAX); ++i)
+	{
+		const ESettingsType settingsType = static_cast<ESettingsType>(i);
+		if (GovernorSteps.Contains(settingsType))
+		{
+			SetSettingsQuality(settingsType, GovernorQualities[i], false);
+		}
+	}
+	if (bApplyEngine)
+	{
+		ApplyEngineChanges(EEasySettingsEngineChange::Scalability);
+	}
+}
+
+void UEasySettingsSubsystem::ApplyAllSettings()
+{
+	// Inside a batch, the commit applies whatever changed
+	if (IsSettingsBatchActive())
+	{
+		bBatchApplyRequested = true;
+		return;
+	}
+
+	EASYSETTINGS_PHASE_SCOPE(ApplySettings);
+	UGameUserSettings* settings = GetGameUserSettings();
+	check(IsValid(settings));
+
+	// The full apply saves too, governed and measured qualities must not end up in the config
+	const bool bGoverned = GovernorSteps.Num() > 0;
+	if (bGoverned)
+	{
+		RestoreGovernedQualities();
+	}
+	const bool bProfiling = RestoreCostProfileLevel();
+	{
+		EASYSETTINGS_PHASE_SCOPE(EngineApply);
+		settings->ApplySettings(true);
+	}
+	AppliedEngineState = FEasySettingsEngineState::Capture(settings);
+	if (bGoverned)
+	{
+		ReapplyGovernedQualities(true);
+	}
+	if (bProfiling)
+	{
+		ReapplyCostProfileLevel(EEasySettingsEngineChange::Scalability | EEasySettingsEngineChange::VSync |
+			EEasySettingsEngineChange::FrameRate);
+	}
+
+	if (IsContainerDirty())
+	{
+		SaveContainer();
+	}
+}
+
+FDelegateHandle UEasySettingsSubsystem::AddContainerValuesListener(uint8 InFirst, uint8 InLast,
+                                                                  FEasySettingsValuesChangedDelegate InDelegate)
+{
+	FContainerListener& listener = ContainerListeners.AddDefaulted_GetRef();
+	listener.First = FMath::Min(InFirst, InLast);
+	listener.Last = FMath::Max(InFirst, InLast);
+	listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	listener.Native = MoveTemp(InDelegate);
+	return listener.Handle;
+}
+
+FDelegateHandle UEasySettingsSubsystem::AddSettingsGroupListener(ESettingsType InSettingsType,
+                                                                 FEasySettingsGroupChangedDelegate InDelegate)
+{
+	check((InSettingsType != ESettingsType::TYPE_NONE));
+	check((InSettingsType != ESettingsType::TYPE_MAX));
+	FGroupListener& listener = GroupListeners.AddDefaulted_GetRef();
+	listener.SettingsType = InSettingsType;
+	listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	listener.Native = MoveTemp(InDelegate);
+	return listener.Handle;
+}
+
+void UEasySettingsSubsystem::RemoveSettingsListener(FDelegateHandle InHandle)
+{
+	ContainerListeners.RemoveAll([&InHandle](const FContainerListener& InListener)
+	{
+		return InListener.Handle == InHandle;
+	});
+	GroupListeners.RemoveAll([&InHandle](const FGroupListener& InListener)
+	{
+		return InListener.Handle == InHandle;
+	});
+}
+
+void UEasySettingsSubsystem::BindContainerValuesChanged(uint8 InFirst, uint8 InLast,
+                                                        FOnEasySettingsValuesChanged InCallback)
+{
+	FContainerListener& listener = ContainerListeners.AddDefaulted_GetRef();
+	listener.First = FMath::Min(InFirst, InLast);
+	listener.Last = FMath::Max(InFirst, InLast);
+	listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	listener.Dynamic = InCallback;
+}
+
+void UEasySettingsSubsystem::UnbindContainerValuesChanged(FOnEasySettingsValuesChanged InCallback)
+{
+	ContainerListeners.RemoveAll([&InCallback](const FContainerListener& InListener)
+	{
+		return InListener.Dynamic == InCallback;
+	});
+}
+
+void UEasySettingsSubsystem::BindSettingsGroupChanged(ESettingsType InSettingsType,
+                                                      FOnEasySettingsGroupChanged InCallback)
+{
+	check((InSettingsType != ESettingsType::TYPE_NONE));
+	check((InSettingsType != ESettingsType::TYPE_MAX));
+	FGroupListener& listener = GroupListeners.AddDefaulted_GetRef();
+	listener.SettingsType = InSettingsType;
+	listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	listener.Dynamic = InCallback;
+}
+
+void UEasySettingsSubsystem::UnbindSettingsGroupChanged(FOnEasySettingsGroupChanged InCallback)
+{
+	GroupListeners.RemoveAll([&InCallback](const FGroupListener& InListener)
+	{
+		return InListener.Dynamic == InCallback;
+	});
+}
+
+void UEasySettingsSubsystem::DispatchSettingsChanges()
+{
+	if (!bContainerLoaded)
+		return;
+	DispatchContainerChanges();
+	DispatchGroupChanges();
+}
+
+void UEasySettingsSubsystem::DispatchContainerChanges()
+{
+	if (!IsValid(SettingsSetter) || !SettingsSetter->HasChangedKeys())
+		return;
+
+	const EasySettings::FKeyBits changedKeys = SettingsSetter->GetChangedKeys();
+	SettingsSetter->ClearChangedKeys();
+
+	// Collect each category once with its latest value, skipping values that ended up unchanged
+	const EasySettings::FContainer& values = SettingsSetter->GetValues();
+	TArray<FEasySettingsValueChange, TInlineAllocator<16>> changes;
+	const EasySettings::FTypedLayout& layout = *values.Layout;
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		const uint8 key = static_cast<uint8>(i);
+		if (!changedKeys[i] || !values.Contains(key))
+			continue;
+		if (!DispatchedContainerValues.Contains(key) || DispatchedContainerValues[key] != values[key])
+		{
+			DispatchedContainerValues.Present[i] = true;
+			DispatchedContainerValues[key] = values[key];
+
+			FEasySettingsValueChange& change = changes.AddDefaulted_GetRef();
+			change.Category = key;
+			change.Value = values[key];
+		}
+
+		// Typed blocks of the same category
+		if (const int32* value = values.FindInt(key))
+		{
+			int32* dispatched = DispatchedContainerValues.FindInt(key);
+			if (dispatched && *dispatched != *value)
+			{
+				*dispatched = *value;
+				FEasySettingsValueChange& change = changes.AddDefaulted_GetRef();
+				change.Category = key;
+				change.Type = EEasySettingsValueType::Int;
+				change.Value = values[key];
+				change.IntValue = *value;
+			}
+		}
+		const int32 boolSlot = layout.FindBoolSlot(key);
+		if (boolSlot != INDEX_NONE && DispatchedContainerValues.Bools.IsValidIndex(boolSlot))
+		{
+			const bool bValue = values.Bools[boolSlot];
+			if (DispatchedContainerValues.Bools[boolSlot] != bValue)
+			{
+				DispatchedContainerValues.Bools[boolSlot] = bValue;
+				FEasySettingsValueChange& change = changes.AddDefaulted_GetRef();
+				change.Category = key;
+				change.Type = EEasySettingsValueType::Bool;
+				change.Value = values[key];
+				change.bBoolValue = bValue;
+			}
+		}
+		if (const FVector4f* value = values.FindVector(key))
+		{
+			FVector4f* dispatched = DispatchedContainerValues.FindVector(key);
+			if (dispatched && *dispatched != *value)
+			{
+				*dispatched = *value;
+				FEasySettingsValueChange& change = changes.AddDefaulted_GetRef();
+				change.Category = key;
+				change.Type = EEasySettingsValueType::Vector;
+				change.Value = values[key];
+				change.VectorValue = FVector4(*value);
+			}
+		}
+	}
+	if (changes.Num() == 0)
+		return;
+
+	// Listeners may add or remove listeners while being called
+	TArray<FContainerListener> listeners = ContainerListeners;
+	TArray<FEasySettingsValueChange> listenerChanges;
+	for (const FContainerListener& listener : listeners)
+	{
+		listenerChanges.Reset();
+		for (const FEasySettingsValueChange& change : changes)
+		{
+			if (change.Category >= listener.First && change.Category <= listener.Last)
+			{
+				listenerChanges.Add(change);
+			}
+		}
+		if (listenerChanges.Num() == 0)
+			continue;
+
+		listener.Native.ExecuteIfBound(listenerChanges);
+		listener.Dynamic.ExecuteIfBound(listenerChanges);
+	}
+}
+
+void UEasySettingsSubsystem::DispatchGroupChanges()
+{
+	if (GroupListeners.Num() == 0)
+		return;
+
+	TArray<FGroupListener> listeners = GroupListeners;
+	for (int32 i = static_cast<int32>(ESettingsType::TYPE_AA); i < static_cast<int32>(ESettingsType::TYPE_MAX); ++i)
+	{
+		const ESettingsType settingsType = static_cast<ESettingsType>(i);
+		const int32 quality = GetSettingsQuality(settingsType);
+		if (quality == DispatchedGroupQualities[i])
+			continue;
+		DispatchedGroupQualities[i] = quality;
+
+		for (const FGroupListener& listener : listeners)
+		{
+			if (listener.SettingsType != settingsType)
+				continue;
+			listener.Native.ExecuteIfBound(settingsType, quality);
+			listener.Dynamic.ExecuteIfBound(settingsType, quality);
+		}
+	}
+}
+
+void UEasySettingsSubsystem::ResetDispatchedState()
+{
+	// The current state is the baseline, listeners only hear about changes from here on
+	if (IsValid(SettingsSetter))
+	{
+		DispatchedContainerValues = SettingsSetter->GetValues();
+		SettingsSetter->ClearChangedKeys();
+	}
+	for (int32 i = static_cast<int32>(ESettingsType::TYPE_AA); i < static_cast<int32>(ESettingsType::TYPE_MAX); ++i)
+	{
+		DispatchedGroupQualities[i] = GetSettingsQuality(static_cast<ESettingsType>(i));
+	}
+}
+
+bool UEasySettingsSubsystem::IsEngineSettingsDirty() const
+{
+	return FEasySettingsEngineState::Capture(GetGameUserSettings()) != AppliedEngineState;
+}
+
+bool UEasySettingsSubsystem::IsContainerDirty() const
+{
+	return IsValid(SettingsSetter) && SettingsSetter->IsDirty();
+}
+
+void UEasySettingsSubsystem::BeginSettingsBatch()
+{
+	if (BatchDepth == 0)
+	{
+		// Remember the state to be able to roll back
+		BatchEngineSnapshot = FEasySettingsEngineState::Capture(GetGameUserSettings());
+		BatchContainerSnapshot.Empty();
+		BatchNamedSnapshot.Reset();
+		if (EnsureContainerLoaded())
+		{
+			BatchContainerSnapshot = SettingsSetter->GetValues();
+			BatchNamedSnapshot = SettingsSetter->GetNamedValues();
+		}
+		bBatchApplyRequested = false;
+		bBatchRollbackRequested = false;
+	}
+	++BatchDepth;
+}
+
+void UEasySettingsSubsystem::CommitSettingsBatch()
+{
+	EndSettingsBatch();
+}
+
+void UEasySettingsSubsystem::CancelSettingsBatch()
+{
+	if (!IsSettingsBatchActive())
+		return;
+	bBatchRollbackRequested = true;
+	EndSettingsBatch();
+}
+
+void UEasySettingsSubsystem::EndSettingsBatch()
+{
+	if (!ensureMsgf(IsSettingsBatchActive(), TEXT("Settings batch closed without being opened")))
+		return;
+
+	--BatchDepth;
+	if (BatchDepth > 0)
+		return;
+
+	const bool bRollback = bBatchRollbackRequested;
+	const bool bApply = bBatchApplyRequested;
+	bBatchApplyRequested = false;
+	bBatchRollbackRequested = false;
+
+	if (bRollback)
+	{
+		RollbackSettingsBatch();
+	}
+	else if (bApply)
+	{
+		ApplySettings();
+	}
+	BatchContainerSnapshot.Empty();
+	BatchNamedSnapshot.Empty();
+}
+
+void UEasySettingsSubsystem::RollbackSettingsBatch()
+{
+	BatchEngineSnapshot.Restore(GetGameUserSettings());
+
+	if (!EnsureContainerLoaded())
+		return;
+
+	// Restore only the values that were changed, so setter overrides see the minimum of calls
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		const uint8 key = static_cast<uint8>(i);
+		float currentValue;
+		if (BatchContainerSnapshot.Contains(key)
+			&& SettingsSetter->GetValue(key, currentValue)
+			&& currentValue != BatchContainerSnapshot[key])
+		{
+			SettingsSetter->SetValue(key, BatchContainerSnapshot[key]);
+		}
+	}
+
+	// Typed setters skip values that did not change
+	const EasySettings::FTypedLayout& layout = *BatchContainerSnapshot.Layout;
+	for (int32 slot = 0; slot < layout.IntKeys.Num(); ++slot)
+	{
+		SettingsSetter->SetIntValue(layout.IntKeys[slot], BatchContainerSnapshot.Ints[slot]);
+	}
+	for (int32 slot = 0; slot < layout.BoolKeys.Num(); ++slot)
+	{
+		SettingsSetter->SetBoolValue(layout.BoolKeys[slot], BatchContainerSnapshot.Bools[slot]);
+	}
+	for (int32 slot = 0; slot < layout.VectorKeys.Num(); ++slot)
+	{
+		SettingsSetter->SetVectorValue(layout.VectorKeys[slot], BatchContainerSnapshot.Vectors[slot]);
+	}
+
+	// Named values set for the first time during the batch go back to 0
+	const int32 namedNum = SettingsSetter->GetNamedValues().Num();
+	for (int32 i = 0; i < namedNum; ++i)
+	{
+		SettingsSetter->SetNamedValue(i, BatchNamedSnapshot.IsValidIndex(i) ? BatchNamedSnapshot[i] : 0.0f);
+	}
+}
+
+void UEasySettingsSubsystem::SaveContainer(bool bFullSnapshot)
+{
+	if (!EnsureContainerLoaded())
+		return;
+
+	EASYSETTINGS_PHASE_SCOPE(SaveContainer);
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	const bool bAsync = developerSettings->bAsyncContainerSave && ContainerWriter.IsValid();
+	if (developerSettings->bJournalContainerChanges && !bFullSnapshot)
+	{
+		AppendContainerJournal();
+		if (ContainerJournalSize < developerSettings->JournalCompactionThreshold)
+			return;
+	}
+
+	// Prepare empty byte container
+	TArray<uint8> bytes;
+	{
+		EASYSETTINGS_PHASE_SCOPE(Serialize);
+		FMemoryWriter writer(bytes);
+
+		// Write bytes from settings
+		SettingsSetter->Write(writer);
+		SettingsSetter->MarkPersisted();
+	}
+
+	// Save to file, the snapshot makes the journal obsolete
+	FString path = GetContainerSavePath();
+	FString journalPath = UEasySettingsLib::GetContainerJournalPath();
+	ContainerJournalSize = 0;
+	if (bAsync)
+	{
+		// Compression and disk write happen on a background task
+		ContainerWriter->EnqueueSnapshot(MoveTemp(bytes), path, journalPath);
+		return;
+	}
+
+	const bool bSuccess = FEasySettingsContainerWriter::WriteSnapshot(bytes, path);
+	if (bSuccess)
+	{
+		IFileManager::Get().Delete(*journalPath, false, true, true);
+	}
+	OnContainerSaved.Broadcast(bSuccess);
+}
+
+void UEasySettingsSubsystem::AppendContainerJournal()
+{
+	EASYSETTINGS_PHASE_SCOPE(AppendJournal);
+	// Prepare empty byte container
+	TArray<uint8> bytes;
+	FMemoryWriter writer(bytes);
+
+	// Only the changed values are recorded
+	if (SettingsSetter->WriteJournal(writer) == 0)
+		return;
+	SettingsSetter->MarkPersisted();
+	ContainerJournalSize += bytes.Num();
+
+	FString journalPath = UEasySettingsLib::GetContainerJournalPath();
+	if (UEasySettingsLib::GetDeveloperSettings()->bAsyncContainerSave && ContainerWriter.IsValid())
+	{
+		ContainerWriter->EnqueueAppend(MoveTemp(bytes), journalPath);
+		return;
+	}
+
+	const bool bSuccess = FEasySettingsContainerWriter::AppendToFile(bytes, journalPath);
+	OnContainerSaved.Broadcast(bSuccess);
+}
+
+void UEasySettingsSubsystem::FlushPendingSaves()
+{
+	if (ContainerWriter.IsValid())
+	{
+		ContainerWriter->Flush();
+	}
+}
+
+bool UEasySettingsSubsystem::HasPendingSaves() const
+{
+	return ContainerWriter.IsValid() && ContainerWriter->HasPendingWork();
+}
+
+void UEasySettingsSubsystem::InitContainer()
+{
+	// Destroy previous container
+	if (IsValid(SettingsSetter))
+	{
+		SettingsSetter->ConditionalBeginDestroy();
+		SettingsSetter = nullptr;
+	}
+	// Create setter based on class from settings
+	TSubclassOf<UEasySettingsSetter> settingsSetterClass = UEasySettingsLib::GetSettingsSetterClass();
+	SettingsSetter = NewObject<UEasySettingsSetter>(this, settingsSetterClass);
+	SettingsSetter->SetSharedValues(SharedContainerValues);
+	SettingsSetter->SetSchema(&ValueSchema);
+	bContainerLoaded = false;
+
+	// Try to read container from disk, reusing the read started at module startup when possible
+	FString path = GetContainerSavePath();
+	PendingContainerLoad = FEasySettingsModule::Get().TakePendingContainerLoad(path);
+	if (!UEasySettingsLib::GetDeveloperSettings()->bAsyncContainerLoad)
+	{
+		if (PendingContainerLoad.IsValid())
+		{
+			FinishContainerLoad();
+			return;
+		}
+		FEasySettingsContainerLoader::FResult loadResult = FEasySettingsContainerLoader::Load(
+			path, UEasySettingsLib::GetContainerJournalPath());
+		ReadContainer(loadResult.bFileExists, loadResult.bReadSucceeded, loadResult.Bytes, loadResult.JournalBytes);
+		return;
+	}
+
+	if (!PendingContainerLoad.IsValid())
+	{
+		PendingContainerLoad = FEasySettingsContainerLoader::Start(path, UEasySettingsLib::GetContainerJournalPath());
+	}
+	ContainerLoadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UEasySettingsSubsystem::PollContainerLoad));
+}
+
+bool UEasySettingsSubsystem::PollContainerLoad(float InDeltaTime)
+{
+	if (PendingContainerLoad.IsValid() && !PendingContainerLoad->IsComplete())
+		return true;
+
+	FinishContainerLoad();
+	return false;
+}
+
+void UEasySettingsSubsystem::FinishContainerLoad()
+{
+	if (ContainerLoadTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ContainerLoadTickerHandle);
+		ContainerLoadTickerHandle.Reset();
+	}
+	if (!PendingContainerLoad.IsValid())
+		return;
+
+	TSharedPtr<FEasySettingsContainerLoader, ESPMode::ThreadSafe> loader = MoveTemp(PendingContainerLoad);
+	FEasySettingsContainerLoader::FResult* loadResult;
+	{
+		// Only blocks if the values are needed before the background read is done
+		EASYSETTINGS_PHASE_SCOPE(LoadWait);
+		loadResult = &loader->Wait();
+	}
+	ReadContainer(loadResult->bFileExists, loadResult->bReadSucceeded, loadResult->Bytes, loadResult->JournalBytes);
+}
+
+bool UEasySettingsSubsystem::EnsureContainerLoaded()
+{
+	if (!bContainerLoaded)
+	{
+		FinishContainerLoad();
+	}
+	return IsValid(SettingsSetter);
+}
+
+void UEasySettingsSubsystem::WaitForContainerLoad()
+{
+	EnsureContainerLoaded();
+}
+
+void UEasySettingsSubsystem::ReadContainer(bool bFileExists, bool bReadSucceeded, const TArray<uint8>& InBytes,
+                                           const TArray<uint8>& InJournalBytes)
+{
+	if (!IsValid(SettingsSetter))
+		return;
+
+	EASYSETTINGS_PHASE_SCOPE(LoadContainer);
+	FString path = GetContainerSavePath();
+	EasySettings::EReadResult result = EasySettings::EReadResult::Failed;
+	// File must exist
+	if (bFileExists)
+	{
+		if (bReadSucceeded)
+		{
+			// Fill settings data
+			EASYSETTINGS_PHASE_SCOPE(Deserialize);
+			FMemoryReader reader(InBytes);
+			result = SettingsSetter->TryRead(reader);
+		}
+		if (result == EasySettings::EReadResult::Failed)
+		{
+			UE_LOG(LogEasySettings, Warning, TEXT("Container '%s' is corrupted or unsupported, resetting to defaults"), *path);
+		}
+	}
+	bContainerLoaded = true;
+	bContainerCreated = !bFileExists;
+
+	if (result == EasySettings::EReadResult::Failed)
+	{
+		SettingsSetter->InitializeEmpty();
+	}
+
+	// Changes appended after the last full save
+	ContainerJournalSize = InJournalBytes.Num();
+	if (InJournalBytes.Num() > 0)
+	{
+		EASYSETTINGS_PHASE_SCOPE(Deserialize);
+		FMemoryReader journalReader(InJournalBytes);
+		SettingsSetter->ReplayJournal(journalReader);
+	}
+	const int32 seeded = SeedContainerDefaults();
+	// Whatever is on disk, gameplay never sees NaNs or out of range values
+	SettingsSetter->SanitizeValues();
+	RestoreConsoleVariableSettings();
+	SettingsSetter->PublishValues();
+
+	const bool bKeepJournal = UEasySettingsLib::GetDeveloperSettings()->bJournalContainerChanges;
+	if (result != EasySettings::EReadResult::Loaded || seeded > 0 || (!bKeepJournal && ContainerJournalSize > 0))
+	{
+		// Save to disk again (create the file, upgrade it to the latest format, store new defaults or merge the journal)
+		SaveContainer(true);
+	}
+	ResetDispatchedState();
+	OnContainerLoaded.Broadcast();
+}
+
+FString UEasySettingsSubsystem::GetContainerSavePath()
+{
+	return UEasySettingsLib::GetContainerSavePath();
+}
+
+void UEasySettingsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	SharedContainerValues = MakeShared<FEasySettingsSharedValues, ESPMode::ThreadSafe>();
+	TWeakObjectPtr<UEasySettingsSubsystem> weakThis(this);
+	ContainerWriter = MakeShared<FEasySettingsContainerWriter, ESPMode::ThreadSafe>([weakThis](bool bSuccess)
+	{
+		if (weakThis.IsValid())
+		{
+			weakThis->OnContainerSaved.Broadcast(bSuccess);
+		}
+	});
+	// The engine has already applied the user settings on startup
+	AppliedEngineState = FEasySettingsEngineState::Capture(GetGameUserSettings());
+	AntiAliasingMethodVariable = FEasySettingsConsoleVariable(TEXT("r.AntiAliasingMethod"));
+	VSyncVariable = FEasySettingsConsoleVariable(TEXT("r.VSync"));
+	ConsoleVariableRegistry.Build(UEasySettingsLib::GetDeveloperSettings()->ConsoleVariableSettings);
+	ValueSchema.Build(UEasySettingsLib::GetDeveloperSettings()->ValueSchema);
+	InvalidateSupportedResolutions();
+	if (FSlateApplication::IsInitialized())
+	{
+		// Monitors plugged in or out, desktop resolution changes
+		DisplayMetricsChangedHandle = FSlateApplication::Get().GetPlatformApplication()->OnDisplayMetricsChanged().
+			AddUObject(this, &UEasySettingsSubsystem::HandleDisplayMetricsChanged);
+	}
+	ResetDispatchedState();
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UEasySettingsSubsystem::DispatchSettingsChanges);
+	InitContainer();
+
+	const UEasySettingsSubsystemDeveloperSettings* developerSettings = UEasySettingsLib::GetDeveloperSettings();
+	if (developerSettings->bEnableQualityGovernor)
+	{
+		SetQualityGovernorEnabled(true);
+	}
+	if (developerSettings->bAutoDetectSettings)
+	{
+		// The benchmark renders, keep it away from the first frames
+		AutoDetectFrame = GFrameCounter + FMath::Max(developerSettings->AutoDetectDelayFrames, 1);
+		AutoDetectTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UEasySettingsSubsystem::PollAutoDetect));
+	}
+	if (FParse::Param(FCommandLine::Get(), TEXT("EasySettingsProfile")))
+	{
+		bQuitAfterCostProfile = true;
+		if (!StartSettingsCostProfile())
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+void UEasySettingsSubsystem::Deinitialize()
+{
+	// A batch that is still open at this point has been abandoned
+	if (IsSettingsBatchActive())
+	{
+		BatchDepth = 1;
+		CancelSettingsBatch();
+	}
+	if (AutoDetectTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AutoDetectTickerHandle);
+		AutoDetectTickerHandle.Reset();
+	}
+	// Neither measured nor governed qualities must reach the user config
+	bQuitAfterCostProfile = false;
+	CancelSettingsCostProfile();
+	SetQualityGovernorEnabled(false);
+	// Never overwrite the file with values that were not loaded yet
+	EnsureContainerLoaded();
+	ApplySettings();
+	FlushPendingSaves();
+	ContainerWriter.Reset();
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	if (DisplayMetricsChangedHandle.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().GetPlatformApplication()->OnDisplayMetricsChanged().Remove(DisplayMetricsChangedHandle);
+	}
+	ContainerListeners.Empty();
+	GroupListeners.Empty();
+	Super::Deinitialize();
+}
+
+FEasySettingsBatchScope::FEasySettingsBatchScope(UEasySettingsSubsystem* InSubsystem)
+	: Subsystem(InSubsystem)
+	, bCancelled(false)
+{
+	if (Subsystem.IsValid())
+	{
+		Subsystem->BeginSettingsBatch();
+	}
+}
+
+FEasySettingsBatchScope::~FEasySettingsBatchScope()
+{
+	if (!Subsystem.IsValid())
+		return;
+
+	if (bCancelled)
+	{
+		Subsystem->CancelSettingsBatch();
+	}
+	else
+	{
+		Subsystem->CommitSettingsBatch();
+	}
 }
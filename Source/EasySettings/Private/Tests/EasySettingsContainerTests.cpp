@@ -0,0 +1,393 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "EasySettingsStats.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Libs/EasySettingsLib.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Subsystems/EasySettingsSubsystem.h"
+#include "Tests/EasySettingsTestSupport.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include <limits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EasySettingsContainerTests
+{
+	using namespace EasySettingsTestSupport;
+
+	constexpr uint32 TEST_FLAGS =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter;
+
+	TStrongObjectPtr<UEasySettingsSetter> MakeSetter(const FEasySettingsSchema& InSchema)
+	{
+		TStrongObjectPtr<UEasySettingsSetter> setter(NewObject<UEasySettingsSetter>(GetTransientPackage()));
+		setter->SetSchema(&InSchema);
+		setter->InitializeEmpty();
+		return setter;
+	}
+
+	/**
+	 * Points the container at a temporary file and turns off every developer setting that runs work of its own on
+	 * initialization (governor, hardware benchmark, journal, background load and save), so subsystem tests do not
+	 * depend on the project configuration and never touch the user container. Everything is put back on destruction.
+	 */
+	class FScopedTestEnvironment
+	{
+	public:
+		FScopedTestEnvironment()
+			: Directory(FPaths::AutomationTransientDir() / TEXT("EasySettings"))
+		{
+			UEasySettingsSubsystemDeveloperSettings* settings = GetMutableDefault<UEasySettingsSubsystemDeveloperSettings>();
+			bEnableQualityGovernor = settings->bEnableQualityGovernor;
+			bAutoDetectSettings = settings->bAutoDetectSettings;
+			bJournalContainerChanges = settings->bJournalContainerChanges;
+			bAsyncContainerSave = settings->bAsyncContainerSave;
+			bAsyncContainerLoad = settings->bAsyncContainerLoad;
+			ConsoleVariableSettings = MoveTemp(settings->ConsoleVariableSettings);
+			ValueSchema = MoveTemp(settings->ValueSchema);
+
+			settings->bEnableQualityGovernor = false;
+			settings->bAutoDetectSettings = false;
+			settings->bJournalContainerChanges = false;
+			settings->bAsyncContainerSave = false;
+			settings->bAsyncContainerLoad = false;
+			settings->ConsoleVariableSettings.Reset();
+			settings->ValueSchema.Reset();
+
+			IFileManager::Get().DeleteDirectory(*Directory, false, true);
+			UEasySettingsLib::SetContainerSavePathOverride(Directory / TEXT("Container.bin"));
+		}
+
+		~FScopedTestEnvironment()
+		{
+			UEasySettingsLib::SetContainerSavePathOverride(FString());
+			IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+			UEasySettingsSubsystemDeveloperSettings* settings = GetMutableDefault<UEasySettingsSubsystemDeveloperSettings>();
+			settings->bEnableQualityGovernor = bEnableQualityGovernor;
+			settings->bAutoDetectSettings = bAutoDetectSettings;
+			settings->bJournalContainerChanges = bJournalContainerChanges;
+			settings->bAsyncContainerSave = bAsyncContainerSave;
+			settings->bAsyncContainerLoad = bAsyncContainerLoad;
+			settings->ConsoleVariableSettings = MoveTemp(ConsoleVariableSettings);
+			settings->ValueSchema = MoveTemp(ValueSchema);
+		}
+
+		UE_NONCOPYABLE(FScopedTestEnvironment);
+
+	private:
+		FString Directory;
+		bool bEnableQualityGovernor;
+		bool bAutoDetectSettings;
+		bool bJournalContainerChanges;
+		bool bAsyncContainerSave;
+		bool bAsyncContainerLoad;
+		TArray<FEasySettingsConsoleVariableEntry> ConsoleVariableSettings;
+		TArray<FEasySettingsValueSchemaEntry> ValueSchema;
+	};
+
+	/** Runs a standalone game instance, so the subsystem goes through its regular initialization. */
+	class FScopedGameInstance
+	{
+	public:
+		FScopedGameInstance()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+		}
+
+		~FScopedGameInstance()
+		{
+			UWorld* world = GameInstance->GetWorld();
+			GameInstance->Shutdown();
+			if (world)
+			{
+				GEngine->DestroyWorldContext(world);
+				world->DestroyWorld(false);
+			}
+			GameInstance->RemoveFromRoot();
+		}
+
+		UEasySettingsSubsystem* GetSubsystem() const { return GameInstance->GetSubsystem<UEasySettingsSubsystem>(); }
+
+		UE_NONCOPYABLE(FScopedGameInstance);
+
+	private:
+		UGameInstance* GameInstance;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsContainerRoundTripTest, "EasySettings.Container.RoundTrip",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsContainerRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace EasySettingsContainerTests;
+	FEasySettingsSchema schema;
+	BuildSchema(schema);
+	TStrongObjectPtr<UEasySettingsSetter> source = MakeSetter(schema);
+	TStrongObjectPtr<UEasySettingsSetter> target = MakeSetter(schema);
+	Fill(source.Get());
+
+	const TArray<uint8> bytes = WriteBytes(source.Get());
+	TestTrue(TEXT("Written container is read back"), ReadBytes(target.Get(), bytes) == EasySettings::EReadResult::Loaded);
+	TestTrue(TEXT("Float, typed and named values survive the round-trip"), HasSameValues(source.Get(), target.Get()));
+
+	int32 intValue = 0;
+	TestTrue(TEXT("Int key is read back"), target->GetIntValue(INT_KEY, intValue));
+	TestEqual(TEXT("Int value survives the round-trip"), intValue, INT_KEY * 3);
+
+	float clampedValue = 0.0f;
+	target->GetValue(CLAMPED_KEY, clampedValue);
+	TestEqual(TEXT("Clamped value survives the round-trip"), clampedValue, CLAMPED_KEY * 0.5f);
+
+	for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+	{
+		if (!target->IsKeyWritten(static_cast<uint8>(i)))
+		{
+			AddError(FString::Printf(TEXT("Key %d lost its written state"), i));
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsContainerTruncatedTest, "EasySettings.Container.Truncated",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsContainerTruncatedTest::RunTest(const FString& Parameters)
+{
+	using namespace EasySettingsContainerTests;
+	FEasySettingsSchema schema;
+	BuildSchema(schema);
+	TStrongObjectPtr<UEasySettingsSetter> source = MakeSetter(schema);
+	TStrongObjectPtr<UEasySettingsSetter> target = MakeSetter(schema);
+	Fill(source.Get());
+	const TArray<uint8> bytes = WriteBytes(source.Get());
+
+	// Cut inside the header, the float block and the trailing section
+	for (const int32 size : {8, bytes.Num() / 2, bytes.Num() - 1})
+	{
+		const TArray<uint8> truncated(bytes.GetData(), size);
+		TestTrue(FString::Printf(TEXT("Container truncated to %d of %d bytes is rejected"), size, bytes.Num()),
+		         ReadBytes(target.Get(), truncated) == EasySettings::EReadResult::Failed);
+	}
+
+	float value = 1.0f;
+	TestTrue(TEXT("Rejected data leaves an empty container"), target->GetValue(10, value) && value == 0.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsContainerCorruptedTest, "EasySettings.Container.Corrupted",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsContainerCorruptedTest::RunTest(const FString& Parameters)
+{
+	using namespace EasySettingsContainerTests;
+	FEasySettingsSchema schema;
+	BuildSchema(schema);
+	TStrongObjectPtr<UEasySettingsSetter> source = MakeSetter(schema);
+	TStrongObjectPtr<UEasySettingsSetter> target = MakeSetter(schema);
+	Fill(source.Get());
+	const TArray<uint8> bytes = WriteBytes(source.Get());
+
+	// A flipped byte in the float block and in the checksum of the last section
+	for (const int32 offset : {bytes.Num() / 4, bytes.Num() - 1})
+	{
+		TArray<uint8> corrupted = bytes;
+		corrupted[offset] ^= 0xFF;
+		TestTrue(FString::Printf(TEXT("Container with byte %d flipped is rejected"), offset),
+		         ReadBytes(target.Get(), corrupted) == EasySettings::EReadResult::Failed);
+	}
+
+	TArray<uint8> swapped;
+	FMemoryWriter writer(swapped);
+	writer.SetByteSwapping(true);
+	AddExpectedError(TEXT("little-endian only"), EAutomationExpectedErrorFlags::Contains, 1);
+	source->Write(writer);
+	TestEqual(TEXT("Byte-swapped data is not written"), swapped.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsContainerSetGetTest, "EasySettings.Container.SetGet",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsContainerSetGetTest::RunTest(const FString& Parameters)
+{
+	using namespace EasySettingsContainerTests;
+	FEasySettingsSchema schema;
+	BuildSchema(schema);
+	TStrongObjectPtr<UEasySettingsSetter> setter = MakeSetter(schema);
+
+	float value = 0.0f;
+	TestFalse(TEXT("Keys past VALUES_NUM are not stored"), setter->GetValue(EasySettings::VALUES_NUM, value));
+	TestFalse(TEXT("Keys start unwritten"), setter->IsKeyWritten(CLAMPED_KEY));
+
+	setter->SetValue(CLAMPED_KEY, 20.0f);
+	TestTrue(TEXT("Set key is stored"), setter->GetValue(CLAMPED_KEY, value));
+	TestEqual(TEXT("Set value is clamped to the schema range"), value, 10.0f);
+	TestTrue(TEXT("Set key is written"), setter->IsKeyWritten(CLAMPED_KEY));
+	TestTrue(TEXT("Set key is dirty"), setter->IsKeyDirty(CLAMPED_KEY));
+
+	setter->MarkPersisted();
+	TestFalse(TEXT("Persisted key is clean"), setter->IsKeyDirty(CLAMPED_KEY));
+	setter->SetValue(CLAMPED_KEY, 10.0f);
+	TestFalse(TEXT("Setting the persisted value keeps the key clean"), setter->IsKeyDirty(CLAMPED_KEY));
+
+	setter->SetValue(CLAMPED_KEY, std::numeric_limits<float>::quiet_NaN());
+	setter->GetValue(CLAMPED_KEY, value);
+	TestEqual(TEXT("NaN is replaced with the schema default"), value, 5.0f);
+
+	int32 intValue = 0;
+	setter->SetIntValue(INT_KEY, 7);
+	TestTrue(TEXT("Declared int key is stored"), setter->GetIntValue(INT_KEY, intValue));
+	TestEqual(TEXT("Int value is read back"), intValue, 7);
+	AddExpectedError(TEXT("is not declared as Int"), EAutomationExpectedErrorFlags::Contains, 1);
+	setter->SetIntValue(CLAMPED_KEY, 7);
+	TestFalse(TEXT("Undeclared int key is not stored"), setter->GetIntValue(CLAMPED_KEY, intValue));
+
+	bool bBoolValue = false;
+	setter->SetBoolValue(BOOL_KEY, true);
+	TestTrue(TEXT("Declared bool key is stored"), setter->GetBoolValue(BOOL_KEY, bBoolValue));
+	TestTrue(TEXT("Bool value is read back"), bBoolValue);
+	TestFalse(TEXT("Undeclared bool key is not stored"), setter->GetBoolValue(INT_KEY, bBoolValue));
+
+	FVector4f vectorValue;
+	setter->SetVectorValue(VECTOR_KEY, FVector4f(0.5f));
+	TestTrue(TEXT("Declared vector key is stored"), setter->GetVectorValue(VECTOR_KEY, vectorValue));
+	TestTrue(TEXT("Vector value is read back"), vectorValue == FVector4f(0.5f));
+	TestFalse(TEXT("Undeclared vector key is not stored"), setter->GetVectorValue(BOOL_KEY, vectorValue));
+
+	const int32 slot = FEasySettingsKeyRegistry::Get().Resolve(NAMED_KEY);
+	float namedValue = 0.0f;
+	setter->SetNamedValue(slot, 0.25f);
+	TestTrue(TEXT("Named value is stored"), setter->GetNamedValue(slot, namedValue));
+	TestEqual(TEXT("Named value is read back"), namedValue, 0.25f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsContainerApplySaveCountsTest, "EasySettings.Container.ApplySaveCounts",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsContainerApplySaveCountsTest::RunTest(const FString& Parameters)
+{
+	using namespace EasySettingsContainerTests;
+	using EasySettings::Stats::EPhase;
+
+	// Declared first, so the game instance is shut down before the environment is restored
+	FScopedTestEnvironment environment;
+	FScopedGameInstance gameInstance;
+	UEasySettingsSubsystem* subsystem = gameInstance.GetSubsystem();
+	if (!TestNotNull(TEXT("Subsystem"), subsystem))
+		return false;
+
+	// Fresh temporary container without a schema, every value is 0 and unclamped
+	const TArray<uint8> keys = {10, 11, 12};
+	EasySettings::Stats::Reset();
+	{
+		FEasySettingsBatchScope batch(subsystem);
+		for (uint8 key : keys)
+		{
+			subsystem->SetContainerValue(key, key * 2.0f);
+		}
+	}
+	TestEqual(TEXT("A batch applies once"), EasySettings::Stats::GetCounters(EPhase::ApplySettings).Calls, 1ll);
+	TestEqual(TEXT("A batch saves the container once"), EasySettings::Stats::GetCounters(EPhase::SaveContainer).Calls, 1ll);
+
+	EasySettings::Stats::Reset();
+	subsystem->SetContainerValue(keys[0], keys[0] * 2.0f);
+	TestEqual(TEXT("Setting the same value applies"), EasySettings::Stats::GetCounters(EPhase::ApplySettings).Calls, 1ll);
+	TestEqual(TEXT("Setting the same value does not save"), EasySettings::Stats::GetCounters(EPhase::SaveContainer).Calls, 0ll);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsEngineDiffTest, "EasySettings.Engine.Diff",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsEngineDiffTest::RunTest(const FString& Parameters)
+{
+	const FEasySettingsEngineState applied;
+
+	FEasySettingsEngineState vsync = applied;
+	vsync.bVSyncEnabled = !applied.bVSyncEnabled;
+	TestTrue(TEXT("A VSync change only differs in VSync"), vsync.Diff(applied) == EEasySettingsEngineChange::VSync);
+
+	FEasySettingsEngineState window = applied;
+	window.FullscreenMode = EWindowMode::WindowedFullscreen;
+	TestTrue(TEXT("A window mode change only differs in Window"), window.Diff(applied) == EEasySettingsEngineChange::Window);
+
+	FEasySettingsEngineState display = applied;
+	display.ResolutionScale = 0.5f;
+	TestTrue(TEXT("A resolution scale change only differs in Display"),
+	         display.Diff(applied) == EEasySettingsEngineChange::Display);
+	display = applied;
+	display.bHDREnabled = !applied.bHDREnabled;
+	TestTrue(TEXT("An HDR change only differs in Display"), display.Diff(applied) == EEasySettingsEngineChange::Display);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasySettingsEngineNarrowApplyTest, "EasySettings.Engine.NarrowApply",
+                                 EasySettingsContainerTests::TEST_FLAGS)
+
+bool FEasySettingsEngineNarrowApplyTest::RunTest(const FString& Parameters)
+{
+	using namespace EasySettingsContainerTests;
+	using EasySettings::Stats::EPhase;
+
+	FScopedTestEnvironment environment;
+	FScopedGameInstance gameInstance;
+	UEasySettingsSubsystem* subsystem = gameInstance.GetSubsystem();
+	if (!TestNotNull(TEXT("Subsystem"), subsystem))
+		return false;
+
+	UGameUserSettings* settings = subsystem->GetGameUserSettings();
+	const FEasySettingsEngineState original = FEasySettingsEngineState::Capture(settings);
+	ON_SCOPE_EXIT
+	{
+		original.Restore(settings);
+		subsystem->ApplySettings();
+	};
+
+	// `ApplyEngineChanges` saves the user config itself, the full engine apply saves inside `ApplySettings(true)`
+	// and records no `EngineSave`
+	EasySettings::Stats::Reset();
+	subsystem->SetVsyncEnabled(!original.bVSyncEnabled);
+	TestEqual(TEXT("A VSync change is applied once"), EasySettings::Stats::GetCounters(EPhase::EngineApply).Calls, 1ll);
+	TestEqual(TEXT("A VSync change goes through ApplyEngineChanges"),
+	          EasySettings::Stats::GetCounters(EPhase::EngineSave).Calls, 1ll);
+	TestEqual(TEXT("A VSync change does not touch the resolution"),
+	          EasySettings::Stats::GetCounters(EPhase::ApplyResolution).Calls, 0ll);
+	TestFalse(TEXT("Nothing is left to apply after a VSync change"), subsystem->IsEngineSettingsDirty());
+
+	EasySettings::Stats::Reset();
+	{
+		FEasySettingsBatchScope batch(subsystem);
+		subsystem->SetVsyncEnabled(original.bVSyncEnabled);
+		subsystem->SetFrameRateLimit(original.FrameRateLimit == 30.0f ? 60 : 30);
+	}
+	TestEqual(TEXT("VSync and frame rate changes go through ApplyEngineChanges"),
+	          EasySettings::Stats::GetCounters(EPhase::EngineSave).Calls, 1ll);
+	TestEqual(TEXT("VSync and frame rate changes do not touch the resolution"),
+	          EasySettings::Stats::GetCounters(EPhase::ApplyResolution).Calls, 0ll);
+
+	EasySettings::Stats::Reset();
+	settings->SetResolutionScaleNormalized(original.ResolutionScale > 0.75f ? 0.5f : 1.0f);
+	TestTrue(TEXT("A resolution scale change is detected"), subsystem->IsEngineSettingsDirty());
+	subsystem->ApplySettings();
+	TestEqual(TEXT("A resolution scale change is applied once"),
+	          EasySettings::Stats::GetCounters(EPhase::EngineApply).Calls, 1ll);
+	TestEqual(TEXT("A resolution scale change takes the full engine apply"),
+	          EasySettings::Stats::GetCounters(EPhase::EngineSave).Calls, 0ll);
+	TestFalse(TEXT("Nothing is left to apply after a resolution scale change"), subsystem->IsEngineSettingsDirty());
+	return true;
+}
+
+#endif
@@ -0,0 +1,102 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsKey.h"
+#include "Data/EasySettingsSchema.h"
+#include "Data/EasySettingsSetter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if !UE_BUILD_SHIPPING
+
+/** Container fixtures shared by the automation tests and the benchmarks. */
+namespace EasySettingsTestSupport
+{
+	constexpr uint8 INT_KEY = 1;
+	constexpr uint8 BOOL_KEY = 2;
+	constexpr uint8 VECTOR_KEY = 3;
+
+	/** Clamped to [0, 10], default 5. */
+	constexpr uint8 CLAMPED_KEY = 4;
+
+	inline const TCHAR* NAMED_KEY = TEXT("EasySettings.Tests.Named");
+
+	/**
+	 * A quarter of the keys declared as int, a quarter as bool and some as vector, like a typical game, and one
+	 * clamped float. `INT_KEY`, `BOOL_KEY`, `VECTOR_KEY` and `CLAMPED_KEY` are part of it.
+	 */
+	inline void BuildSchema(FEasySettingsSchema& OutSchema)
+	{
+		TArray<FEasySettingsValueSchemaEntry> entries;
+		for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+		{
+			const EEasySettingsValueType type = i % 4 == 1 ? EEasySettingsValueType::Int
+				                                    : i % 4 == 2 ? EEasySettingsValueType::Bool
+				                                    : i % 16 == 3 ? EEasySettingsValueType::Vector
+				                                    : EEasySettingsValueType::Float;
+			if (type == EEasySettingsValueType::Float && i != CLAMPED_KEY)
+				continue;
+			FEasySettingsValueSchemaEntry& entry = entries.AddDefaulted_GetRef();
+			entry.ContainerKey = static_cast<uint8>(i);
+			entry.Type = type;
+			if (i == CLAMPED_KEY)
+			{
+				entry.Min = 0.0f;
+				entry.Max = 10.0f;
+				entry.Default = 5.0f;
+			}
+		}
+		OutSchema.Build(entries);
+	}
+
+	/** Gives every key and one named value a distinct value, so a round-trip can be verified. */
+	inline void Fill(UEasySettingsSetter* InSetter)
+	{
+		InSetter->InitializeEmpty();
+		for (int32 i = 0; i < EasySettings::VALUES_NUM; ++i)
+		{
+			InSetter->SetValue(static_cast<uint8>(i), i * 0.5f);
+		}
+		const EasySettings::FTypedLayout& layout = *InSetter->GetValues().Layout;
+		for (uint8 key : layout.IntKeys)
+		{
+			InSetter->SetIntValue(key, key * 3);
+		}
+		for (uint8 key : layout.BoolKeys)
+		{
+			InSetter->SetBoolValue(key, (key & 2) != 0);
+		}
+		for (uint8 key : layout.VectorKeys)
+		{
+			InSetter->SetVectorValue(key, FVector4f(key, key * 0.5f, key * 0.25f, 1.0f));
+		}
+		InSetter->SetNamedValue(FEasySettingsKeyRegistry::Get().Resolve(NAMED_KEY), 0.75f);
+	}
+
+	inline bool HasSameValues(UEasySettingsSetter* InExpected, UEasySettingsSetter* InActual)
+	{
+		const EasySettings::FContainer& expected = InExpected->GetValues();
+		const EasySettings::FContainer& actual = InActual->GetValues();
+		return FMemory::Memcmp(expected.Values, actual.Values, sizeof(expected.Values)) == 0
+			&& expected.Ints == actual.Ints && expected.Bools == actual.Bools && expected.Vectors == actual.Vectors
+			&& InExpected->GetNamedValues() == InActual->GetNamedValues();
+	}
+
+	inline TArray<uint8> WriteBytes(UEasySettingsSetter* InSetter)
+	{
+		TArray<uint8> bytes;
+		FMemoryWriter writer(bytes);
+		InSetter->Write(writer);
+		return bytes;
+	}
+
+	inline EasySettings::EReadResult ReadBytes(UEasySettingsSetter* InSetter, const TArray<uint8>& InBytes)
+	{
+		FMemoryReader reader(InBytes);
+		return InSetter->TryRead(reader);
+	}
+}
+
+#endif
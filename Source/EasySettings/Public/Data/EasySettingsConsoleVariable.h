@@ -0,0 +1,55 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * @brief A cached handle to a console variable.
+ * 
+ * The variable is looked up by name on first use only, after that it is read and written directly
+ * without any string parsing or player controller. Values are written with `ECVF_SetByGameOverride`, above the
+ * project, system and device profile config files (which would otherwise silently win over a player choice) but
+ * below `ConsoleVariables.ini`, the command line and the console.
+ */
+class EASYSETTINGS_API FEasySettingsConsoleVariable
+{
+public:
+	FEasySettingsConsoleVariable() = default;
+	explicit FEasySettingsConsoleVariable(const FString& InName);
+
+	/**
+	 * @brief Looks the variable up if it has not been found yet.
+	 * 
+	 * @return true if the variable exists.
+	 */
+	bool Resolve() const;
+
+	/** Checks whether the variable exists, resolving it if needed. */
+	bool IsValid() const { return Resolve(); }
+
+	/** The name of the console variable. */
+	const FString& GetName() const { return Name; }
+
+	/** The resolved variable, or nullptr if it does not exist. */
+	IConsoleVariable* Get() const { return Resolve() ? Variable : nullptr; }
+
+	int32 GetInt(int32 InDefault = 0) const;
+	float GetFloat(float InDefault = 0.0f) const;
+	bool GetBool(bool bInDefault = false) const;
+
+	/**
+	 * @brief Writes a value with the given priority.
+	 * 
+	 * @return true if the variable exists and holds the value afterwards, false if it is missing or the write was
+	 * ignored because the current value was set with a higher priority.
+	 */
+	bool SetInt(int32 InValue, EConsoleVariableFlags InSetBy = ECVF_SetByGameOverride) const;
+	bool SetFloat(float InValue, EConsoleVariableFlags InSetBy = ECVF_SetByGameOverride) const;
+	bool SetBool(bool bInValue, EConsoleVariableFlags InSetBy = ECVF_SetByGameOverride) const;
+
+private:
+	FString Name;
+	mutable IConsoleVariable* Variable = nullptr;
+};
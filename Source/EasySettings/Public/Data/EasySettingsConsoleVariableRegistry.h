@@ -0,0 +1,73 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsConsoleVariable.h"
+#include "EasySettingsSubsystemDeveloperSettings.h"
+
+/**
+ * @brief Indexed registry of the console variable settings declared in the developer settings.
+ * 
+ * Entries are resolved once into a flat array with cached console variable handles,
+ * so reading and writing a setting by index does not involve any name lookup.
+ */
+class EASYSETTINGS_API FEasySettingsConsoleVariableRegistry
+{
+public:
+	/**
+	 * @brief Rebuilds the registry from a list of entries.
+	 * 
+	 * Entries without a name or console variable, and entries with a duplicate name, are skipped.
+	 * 
+	 * @param InEntries The declared settings.
+	 */
+	void Build(const TArray<FEasySettingsConsoleVariableEntry>& InEntries);
+
+	/** Number of registered settings. */
+	int32 Num() const { return Entries.Num(); }
+
+	bool IsValidIndex(int32 InIndex) const { return Entries.IsValidIndex(InIndex); }
+
+	/**
+	 * @brief Finds the index of a setting by name.
+	 * 
+	 * @param InName The setting name.
+	 * @return The index, or `INDEX_NONE` if the setting does not exist.
+	 */
+	int32 FindIndex(FName InName) const;
+
+	const FEasySettingsConsoleVariableEntry& GetEntry(int32 InIndex) const { return Entries[InIndex]; }
+	const FEasySettingsConsoleVariable& GetVariable(int32 InIndex) const { return Variables[InIndex]; }
+
+	/**
+	 * @brief Clamps a value to the range of a setting and converts it to its type.
+	 * 
+	 * @param InIndex The setting index.
+	 * @param InValue The value to sanitize.
+	 * @return The value that would be written to the console variable.
+	 */
+	float Sanitize(int32 InIndex, float InValue) const;
+
+	/**
+	 * @brief Reads the current value of a setting from its console variable.
+	 * 
+	 * @param InIndex The setting index.
+	 * @return The value, or the setting default if the console variable does not exist.
+	 */
+	float GetValue(int32 InIndex) const;
+
+	/**
+	 * @brief Writes a sanitized value to the console variable of a setting.
+	 * 
+	 * @param InIndex The setting index.
+	 * @param InValue The value to write.
+	 * @return true if the console variable exists and now holds the value.
+	 */
+	bool SetValue(int32 InIndex, float InValue) const;
+
+private:
+	TArray<FEasySettingsConsoleVariableEntry> Entries;
+	TArray<FEasySettingsConsoleVariable> Variables;
+	TMap<FName, int32> IndexByName;
+};
@@ -0,0 +1,77 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsType.h"
+#include "EasySettingsCostProfile.generated.h"
+
+/**
+ * @brief Frame cost measured with one settings group at one quality level, all other groups at the user settings.
+ */
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsCostSample
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	ESettingsType SettingsType = ESettingsType::TYPE_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	int32 Quality = 0;
+
+	/** Number of frames the averages were taken over. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	int32 Frames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	float FrameTimeMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	float MaxFrameTimeMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	float GameThreadMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	float RenderThreadMs = 0.0f;
+
+	/** 0 when nothing is rendered, e.g. with `-nullrhi`. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	float GPUMs = 0.0f;
+
+	/** Slowest of game thread, render thread and GPU, taken per frame and averaged. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Cost Profile")
+	float BottleneckMs = 0.0f;
+
+public:
+	/**
+	 * @brief Writes a cost table with one row per group and quality level.
+	 *
+	 * @param InSamples The measured samples.
+	 * @param InPath Target file path.
+	 * @return true if the file was written.
+	 */
+	static bool WriteCsv(const TArray<FEasySettingsCostSample>& InSamples, const FString& InPath);
+
+	/**
+	 * @brief Writes the cost table as JSON, samples grouped by settings group.
+	 *
+	 * @param InSamples The measured samples.
+	 * @param InPath Target file path.
+	 * @return true if the file was written.
+	 */
+	static bool WriteJson(const TArray<FEasySettingsCostSample>& InSamples, const FString& InPath);
+
+	/**
+	 * @brief Orders the measured groups from the most to the least expensive.
+	 *
+	 * The cost of a group is the `BottleneckMs` difference between its highest and lowest measured level, the same
+	 * work time the governor samples, so the result can be used as `GovernorStepOrder`.
+	 *
+	 * @param InSamples The measured samples.
+	 * @return The groups, most expensive first.
+	 */
+	static TArray<ESettingsType> SortGroupsByCost(const TArray<FEasySettingsCostSample>& InSamples);
+};
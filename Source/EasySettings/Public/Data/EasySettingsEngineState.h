@@ -0,0 +1,174 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsType.h"
+#include "GameFramework/GameUserSettings.h"
+#include "EasySettingsEngineState.generated.h"
+
+/** Categories of engine settings that are applied separately. */
+enum class EEasySettingsEngineChange : uint8
+{
+	None = 0,
+
+	/** Screen resolution or window mode. */
+	Window = 1 << 0,
+
+	/** Any scalability group. */
+	Scalability = 1 << 1,
+
+	/** VSync. */
+	VSync = 1 << 2,
+
+	/** Frame rate limit. */
+	FrameRate = 1 << 3,
+
+	/** Audio quality level. */
+	Audio = 1 << 4,
+	/** Resolution scale, dynamic resolution or HDR output, only the full engine apply covers them. */
+	Display = 1 << 5
+};
+ENUM_CLASS_FLAGS(EEasySettingsEngineChange);
+
+/**
+ * @brief A snapshot of the `UGameUserSettings` values managed by the Easy Settings subsystem.
+ *
+ * Holds every scalability group, window and frame settings that the subsystem setters touch, and the display
+ * settings only reachable through `GetGameUserSettings()`, so the state can be captured, compared and restored as a
+ * single value.
+ */
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsEngineState
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 AntiAliasingQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 TextureQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 VisualEffectQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 PostProcessingQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 ShadingQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 FoliageQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 ReflectionQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 GlobalIlluminationQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 ViewDistanceQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 ShadowQuality = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Scalability")
+	int32 AudioQualityLevel = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Frame")
+	bool bVSyncEnabled = false;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Frame")
+	float FrameRateLimit = 0.0f;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Window")
+	TEnumAsByte<EWindowMode::Type> FullscreenMode = EWindowMode::Type::Windowed;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Window")
+	FIntPoint ScreenResolution = FIntPoint::ZeroValue;
+
+	/** Normalized resolution scale, 0 to 1. */
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Display")
+	float ResolutionScale = 1.0f;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Display")
+	bool bDynamicResolutionEnabled = false;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Display")
+	bool bHDREnabled = false;
+
+	UPROPERTY(BlueprintReadWrite, Category="EasySettings|Display")
+	int32 HDRDisplayNits = 1000;
+
+public:
+	/**
+	 * @brief Captures the current values of the given game user settings.
+	 *
+	 * @param InSettings The settings object to read from.
+	 * @return The captured state.
+	 */
+	static FEasySettingsEngineState Capture(const UGameUserSettings* InSettings);
+
+	/**
+	 * @brief Writes this state back into the given game user settings.
+	 *
+	 * Only the in-memory values are changed, nothing is applied or saved. The exception is HDR output, which the
+	 * engine applies as soon as it is changed; it is only written when it differs.
+	 *
+	 * @param InSettings The settings object to write to.
+	 */
+	void Restore(UGameUserSettings* InSettings) const;
+
+	/**
+	 * @brief Writes only the values that differ from another state into the given game user settings.
+	 *
+	 * Only the in-memory values are changed, nothing is applied or saved.
+	 *
+	 * @param InSettings The settings object to write to.
+	 * @param InCurrent The state the settings object currently holds.
+	 * @return The number of values that were written.
+	 */
+	int32 RestoreChanged(UGameUserSettings* InSettings, const FEasySettingsEngineState& InCurrent) const;
+
+	/**
+	 * @brief The quality of a settings group, the lowest of the values the group drives.
+	 *
+	 * @param InSettingsType The group.
+	 * @return The group quality.
+	 */
+	int32 GetGroupQuality(ESettingsType InSettingsType) const;
+
+	/**
+	 * @brief Writes the values of a single settings group into the given game user settings.
+	 *
+	 * @param InSettingsType The group to write.
+	 * @param InSettings The settings object to write to.
+	 */
+	void RestoreGroup(ESettingsType InSettingsType, UGameUserSettings* InSettings) const;
+
+	/**
+	 * @brief Copies the display settings (resolution scale, dynamic resolution, HDR) from the given game user settings.
+	 *
+	 * @param InSettings The settings object to read from.
+	 */
+	void CaptureDisplay(const UGameUserSettings* InSettings);
+
+	/** Serializes every value except the display settings, which were added later and are written separately. */
+	friend FArchive& operator<<(FArchive& Ar, FEasySettingsEngineState& State);
+
+	/** Serializes the display settings. */
+	void SerializeDisplay(FArchive& Ar);
+
+	/**
+	 * @brief Tells which categories differ between two states.
+	 *
+	 * @param Other The state to compare with.
+	 * @return The categories with at least one differing value.
+	 */
+	EEasySettingsEngineChange Diff(const FEasySettingsEngineState& Other) const;
+
+	bool operator==(const FEasySettingsEngineState& Other) const;
+	bool operator!=(const FEasySettingsEngineState& Other) const { return !(*this == Other); }
+};
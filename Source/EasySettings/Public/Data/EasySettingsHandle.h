@@ -0,0 +1,181 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsSetter.h"
+#include "Subsystems/EasySettingsSubsystem.h"
+
+namespace EasySettings
+{
+	/**
+	 * Maps a value type onto its block of `FContainer` and the subsystem setter that writes it. `FindSlot` resolves a
+	 * key to its index in the block, `INDEX_NONE` if the key has no slot of that type.
+	 */
+	template <typename ValueType, typename Enable = void>
+	struct TSlotTraits
+	{
+		static_assert(sizeof(ValueType) == 0, "TEasySetting supports float, int32, bool, FVector4f and enum types");
+	};
+
+	template <>
+	struct TSlotTraits<float>
+	{
+		static int32 FindSlot(const FContainer& InContainer, uint8 InKey)
+		{
+			return InContainer.Contains(InKey) ? InKey : INDEX_NONE;
+		}
+
+		static FORCEINLINE float Read(const FContainer& InContainer, int32 InSlot) { return InContainer.Values[InSlot]; }
+
+		static void Write(UEasySettingsSubsystem* InSubsystem, uint8 InKey, float InValue, bool bApply)
+		{
+			InSubsystem->SetContainerValue(InKey, InValue, bApply);
+		}
+	};
+
+	template <>
+	struct TSlotTraits<int32>
+	{
+		static int32 FindSlot(const FContainer& InContainer, uint8 InKey) { return InContainer.Layout->FindIntSlot(InKey); }
+
+		static FORCEINLINE int32 Read(const FContainer& InContainer, int32 InSlot) { return InContainer.Ints[InSlot]; }
+
+		static void Write(UEasySettingsSubsystem* InSubsystem, uint8 InKey, int32 InValue, bool bApply)
+		{
+			InSubsystem->SetContainerInt(InKey, InValue, bApply);
+		}
+	};
+
+	template <>
+	struct TSlotTraits<bool>
+	{
+		static int32 FindSlot(const FContainer& InContainer, uint8 InKey) { return InContainer.Layout->FindBoolSlot(InKey); }
+
+		static FORCEINLINE bool Read(const FContainer& InContainer, int32 InSlot) { return InContainer.Bools[InSlot]; }
+
+		static void Write(UEasySettingsSubsystem* InSubsystem, uint8 InKey, bool bInValue, bool bApply)
+		{
+			InSubsystem->SetContainerBool(InKey, bInValue, bApply);
+		}
+	};
+
+	template <>
+	struct TSlotTraits<FVector4f>
+	{
+		static int32 FindSlot(const FContainer& InContainer, uint8 InKey)
+		{
+			return InContainer.Layout->FindVectorSlot(InKey);
+		}
+
+		static FORCEINLINE const FVector4f& Read(const FContainer& InContainer, int32 InSlot)
+		{
+			return InContainer.Vectors[InSlot];
+		}
+
+		static void Write(UEasySettingsSubsystem* InSubsystem, uint8 InKey, const FVector4f& InValue, bool bApply)
+		{
+			InSubsystem->SetContainerVector(InKey, FVector4(InValue), bApply);
+		}
+	};
+
+	/** Enums live in the int block, like `SetContainerEnum`. */
+	template <typename EnumType>
+	struct TSlotTraits<EnumType, typename TEnableIf<TIsEnum<EnumType>::Value>::Type>
+	{
+		static int32 FindSlot(const FContainer& InContainer, uint8 InKey) { return InContainer.Layout->FindIntSlot(InKey); }
+
+		static FORCEINLINE EnumType Read(const FContainer& InContainer, int32 InSlot)
+		{
+			return static_cast<EnumType>(InContainer.Ints[InSlot]);
+		}
+
+		static void Write(UEasySettingsSubsystem* InSubsystem, uint8 InKey, EnumType InValue, bool bApply)
+		{
+			InSubsystem->SetContainerEnum(InKey, InValue, bApply);
+		}
+	};
+}
+
+/**
+ * @brief Typed handle to a container category, bound once to its storage slot.
+ *
+ * The key is checked against `VALUES_NUM` at compile time and the value type selects the block it lives in. The slot
+ * is resolved when binding, so a read is an inline load from the container with no subsystem lookup or virtual call.
+ * Writes go through the subsystem, which keeps dirty tracking, persistence and change listeners working.
+ *
+ * Int, bool, vector and enum handles only bind to categories declared with that type in the value schema.
+ *
+ * The binding stays valid for the lifetime of the subsystem it was bound to. Game thread only.
+ *
+ * @code
+ * typedef TEasySetting<float, 10> FMouseSensitivity;
+ * FMouseSensitivity Sensitivity;
+ * Sensitivity.Bind(subsystem);            // once, e.g. in BeginPlay
+ * const float sensitivity = Sensitivity.Get(); // per frame
+ * @endcode
+ *
+ * @tparam ValueType float, int32, bool, FVector4f or an enum type.
+ * @tparam Key The category key (`uint8`).
+ */
+template <typename ValueType, uint8 Key>
+class TEasySetting
+{
+	static_assert(Key < EasySettings::VALUES_NUM, "TEasySetting key must be lower than EasySettings::VALUES_NUM");
+
+	typedef EasySettings::TSlotTraits<ValueType> FTraits;
+
+public:
+	TEasySetting() = default;
+
+	explicit TEasySetting(UEasySettingsSubsystem* InSubsystem)
+	{
+		Bind(InSubsystem);
+	}
+
+	/**
+	 * @brief Binds the handle to the storage of a subsystem, finishing a pending container load if needed.
+	 *
+	 * @param InSubsystem The subsystem, may be null to unbind.
+	 * @return true if the handle is bound, false if the category has no slot of the handle type.
+	 */
+	bool Bind(UEasySettingsSubsystem* InSubsystem)
+	{
+		Subsystem = InSubsystem;
+		Container = IsValid(InSubsystem) ? InSubsystem->GetContainerStorage() : nullptr;
+		Slot = Container ? FTraits::FindSlot(*Container, Key) : INDEX_NONE;
+		if (Slot == INDEX_NONE)
+		{
+			Container = nullptr;
+		}
+		return IsBound();
+	}
+
+	FORCEINLINE bool IsBound() const { return Container != nullptr; }
+
+	/** Reads the value. The handle must be bound. */
+	FORCEINLINE decltype(auto) Get() const
+	{
+		checkSlow(IsBound());
+		return FTraits::Read(*Container, Slot);
+	}
+
+	/**
+	 * @brief Writes the value through the subsystem.
+	 *
+	 * @param InValue The new value.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	void Set(const ValueType& InValue, bool bApply = true) const
+	{
+		checkSlow(IsBound());
+		FTraits::Write(Subsystem, Key, InValue, bApply);
+	}
+
+	static constexpr uint8 GetKey() { return Key; }
+
+private:
+	UEasySettingsSubsystem* Subsystem = nullptr;
+	const EasySettings::FContainer* Container = nullptr;
+	int32 Slot = INDEX_NONE;
+};
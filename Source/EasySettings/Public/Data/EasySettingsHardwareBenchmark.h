@@ -0,0 +1,88 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EasySettingsHardwareBenchmark.generated.h"
+
+/**
+ * @brief Result of the engine hardware benchmark, mapped to the settings groups of the Easy Settings subsystem.
+ *
+ * The result is cached in the user settings config together with a fingerprint of the hardware and graphics driver,
+ * so the benchmark only has to run again when either of them changes.
+ */
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsHardwareBenchmark
+{
+	GENERATED_BODY()
+
+public:
+	/** CPU performance index, 100 is the engine reference machine. */
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	float CPUScore = 0.0f;
+
+	/** GPU performance index, 100 is the engine reference machine. */
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	float GPUScore = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	int32 AntiAliasingQuality = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	int32 TextureQuality = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	int32 EffectsQuality = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	int32 DetailsQuality = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	int32 ShadowsQuality = 0;
+
+	/** Suggested screen resolution, zero to keep the current one. */
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	FIntPoint Resolution = FIntPoint::ZeroValue;
+
+	/** Suggested frame rate limit, 0 for unlimited. */
+	UPROPERTY(BlueprintReadOnly, Category="EasySettings|Benchmark")
+	int32 FrameRateLimit = 0;
+
+public:
+	/**
+	 * @brief Runs the engine synthetic benchmark and maps its scores to settings.
+	 *
+	 * Renders on the game and render threads for a short moment, so it should not run while the first frames are drawn.
+	 *
+	 * @param InWorkScale Benchmark work scale, higher is more precise and slower.
+	 * @param OutResult Receives the result.
+	 * @return false if nothing can be rendered (e.g. a dedicated server).
+	 */
+	static bool Run(int32 InWorkScale, FEasySettingsHardwareBenchmark& OutResult);
+
+	/**
+	 * @brief Identifies the CPU, GPU, graphics driver and memory of this machine.
+	 *
+	 * @return A short string that changes whenever any of them changes.
+	 */
+	static FString ComputeFingerprint();
+
+	/**
+	 * @brief Reads the cached result from the user settings config.
+	 *
+	 * @param OutFingerprint Receives the fingerprint the result was computed with.
+	 * @param OutResult Receives the result.
+	 * @return true if a result has been cached.
+	 */
+	static bool LoadCached(FString& OutFingerprint, FEasySettingsHardwareBenchmark& OutResult);
+
+	/**
+	 * @brief Writes this result to the user settings config.
+	 *
+	 * @param InFingerprint The fingerprint of the machine the result was computed on.
+	 */
+	void SaveCached(const FString& InFingerprint) const;
+
+	/** The lowest quality of all groups, used to pick the resolution and frame rate limit. */
+	int32 GetOverallQuality() const;
+};
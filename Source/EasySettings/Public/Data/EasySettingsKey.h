@@ -0,0 +1,104 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+namespace EasySettings
+{
+	/**
+	 * @brief 64-bit FNV-1a hash of a setting name, usable in constant expressions.
+	 *
+	 * Names are case-sensitive.
+	 */
+	constexpr uint64 HashKeyName(const TCHAR* InName)
+	{
+		uint64 hash = 0xcbf29ce484222325ull;
+		for (; *InName; ++InName)
+		{
+			hash = (hash ^ static_cast<uint64>(*InName)) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+}
+
+/**
+ * @brief Process-wide table mapping setting names to dense slot indices.
+ *
+ * Slots are handed out in registration order and never change while the process runs. Names read from the container
+ * file are registered as well, so values of keys no code has asked for yet are kept and written back.
+ */
+class EASYSETTINGS_API FEasySettingsKeyRegistry
+{
+public:
+	static FEasySettingsKeyRegistry& Get();
+
+	/**
+	 * @brief Maps a name to its slot, registering it if needed.
+	 *
+	 * @param InHash `EasySettings::HashKeyName` of the name.
+	 * @param InName The setting name.
+	 * @return The slot index, or `INDEX_NONE` if the name is empty or its hash collides with another name.
+	 */
+	int32 Resolve(uint64 InHash, const TCHAR* InName);
+	int32 Resolve(const FString& InName) { return Resolve(EasySettings::HashKeyName(*InName), *InName); }
+
+	/** Number of registered slots. */
+	int32 Num() const;
+
+	bool IsValidSlot(int32 InSlot) const { return InSlot >= 0 && InSlot < Num(); }
+
+	/** The name of a slot, or an empty string if the slot does not exist. */
+	FString GetName(int32 InSlot) const;
+
+private:
+	mutable FCriticalSection Mutex;
+	TMap<uint64, int32> SlotByHash;
+	TArray<FString> Names;
+};
+
+/**
+ * @brief A named setting key.
+ *
+ * The name is hashed at compile time and mapped to its slot on first use only, so accessing a value through the key
+ * is a single indexed access. The slot is cached atomically, so a key may be shared between threads, and a name that
+ * cannot be registered is cached as `INDEX_NONE` so it is only reported once. Declare keys as static constants:
+ *
+ * @code
+ * static const FEasySettingsKey FieldOfViewKey(TEXT("Camera.FieldOfView"));
+ * subsystem->SetNamedValue(FieldOfViewKey, 90.0f);
+ * @endcode
+ */
+class FEasySettingsKey
+{
+public:
+	constexpr explicit FEasySettingsKey(const TCHAR* InName)
+		: Name(InName)
+		, Hash(EasySettings::HashKeyName(InName))
+	{
+	}
+
+	const TCHAR* GetName() const { return Name; }
+	constexpr uint64 GetHash() const { return Hash; }
+
+	/** The slot of the key, registered on the first call, or `INDEX_NONE` if the name cannot be registered. */
+	int32 GetSlot() const
+	{
+		int32 slot = Slot.load(std::memory_order_relaxed);
+		if (slot == UNRESOLVED_SLOT)
+		{
+			// Resolving is idempotent, so threads racing here all store the same slot
+			slot = FEasySettingsKeyRegistry::Get().Resolve(Hash, Name);
+			Slot.store(slot, std::memory_order_relaxed);
+		}
+		return slot;
+	}
+
+private:
+	static constexpr int32 UNRESOLVED_SLOT = INDEX_NONE - 1;
+
+	const TCHAR* Name;
+	uint64 Hash;
+	mutable std::atomic<int32> Slot{UNRESOLVED_SLOT};
+};
@@ -0,0 +1,62 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsEngineState.h"
+#include "EasySettingsProfile.generated.h"
+
+/**
+ * @brief A named set of settings (e.g. Low, Medium, High, Ultra or a custom preset).
+ *
+ * Holds every engine setting managed by the subsystem and, optionally, all container values (float, typed and named),
+ * so it can be captured, saved, loaded and applied as a unit.
+ */
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsProfile
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	FEasySettingsEngineState EngineState;
+
+	/** Container values indexed by category, empty if the profile does not include the container. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	TArray<float> ContainerValues;
+
+	/** Values of the categories declared as int, keyed by category. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	TMap<uint8, int32> ContainerInts;
+
+	/** Values of the categories declared as bool, keyed by category. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	TMap<uint8, bool> ContainerBools;
+
+	/** Values of the categories declared as vector, keyed by category. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	TMap<uint8, FVector4> ContainerVectors;
+
+	/** Named values keyed by their name, see `FEasySettingsKey`. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EasySettings|Profile")
+	TMap<FString, float> NamedValues;
+
+public:
+	/**
+	 * @brief Serializes the profile with a small versioned header.
+	 *
+	 * @param MemoryWriter A reference to the `FMemoryWriter` to which the data will be written.
+	 */
+	void Write(FMemoryWriter& MemoryWriter) const;
+
+	/**
+	 * @brief Deserializes a profile written by `Write`.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` from which to read the data.
+	 * @return false if the data is not a profile, is truncated or comes from a newer version.
+	 */
+	bool Read(FMemoryReader& MemoryReader);
+};
@@ -0,0 +1,72 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsSetter.h"
+#include "EasySettingsSubsystemDeveloperSettings.h"
+
+/**
+ * @brief Dense validation tables built from the value schema declared in the developer settings.
+ *
+ * Minimums, maximums and defaults are laid out like the container float block, so the whole block is validated with
+ * SIMD registers four values at a time: non-finite values are replaced with their default, then every value is
+ * clamped to its range. Stepped categories are snapped afterwards in a short scalar pass.
+ *
+ * The int, bool and vector categories declared in the schema make up the typed layout of the container.
+ */
+class EASYSETTINGS_API FEasySettingsSchema
+{
+public:
+	FEasySettingsSchema();
+
+	/**
+	 * @brief Rebuilds the tables from a list of entries.
+	 *
+	 * Entries with an out of range key are skipped, the last entry of a key wins. Only float entries have a range.
+	 *
+	 * @param InEntries The declared schema.
+	 */
+	void Build(const TArray<FEasySettingsValueSchemaEntry>& InEntries);
+
+	/** Float categories that have a schema entry. */
+	const TArray<uint8>& GetKeys() const { return Keys; }
+
+	/** The int, bool and vector categories, shared with every container using this schema. */
+	const TSharedRef<const EasySettings::FTypedLayout>& GetLayout() const { return Layout; }
+
+	float GetDefault(uint8 InKey) const { return Defaults[InKey]; }
+
+	/**
+	 * @brief Sanitizes a single value of a category.
+	 *
+	 * @param InKey The category key (`uint8`).
+	 * @param InValue The value to validate.
+	 * @return The value that may be stored.
+	 */
+	float Sanitize(uint8 InKey, float InValue) const;
+
+	/**
+	 * @brief Validates the whole float block of a container in one sweep.
+	 *
+	 * @param InOutValues The container to repair in place.
+	 * @param OutRepairedKeys Receives one bit per present category whose value was changed.
+	 * @return Number of repaired present categories.
+	 */
+	int32 SanitizeAll(EasySettings::FContainer& InOutValues, EasySettings::FKeyBits& OutRepairedKeys) const;
+
+private:
+	float Snap(uint8 InKey, float InValue) const;
+
+	alignas(16) float Mins[EasySettings::VALUES_CAPACITY];
+	alignas(16) float Maxs[EasySettings::VALUES_CAPACITY];
+	alignas(16) float Defaults[EasySettings::VALUES_CAPACITY];
+	float Steps[EasySettings::VALUES_CAPACITY];
+
+	TArray<uint8> Keys;
+
+	/** Categories with a non-zero step. */
+	TArray<uint8> SteppedKeys;
+
+	TSharedRef<const EasySettings::FTypedLayout> Layout;
+};
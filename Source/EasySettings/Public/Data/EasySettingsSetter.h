@@ -3,15 +3,236 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StaticBitArray.h"
 #include "UObject/Object.h"
 #include "EasySettingsSetter.generated.h"
 
+class FEasySettingsSchema;
+class FEasySettingsSharedValues;
+
 namespace EasySettings
 {
 	constexpr int32 VALUES_NUM = 254;
+
+	/** Number of allocated slots, rounded up to a multiple of 4 so the block can be processed with vector registers. */
+	constexpr int32 VALUES_CAPACITY = (VALUES_NUM + 3) & ~3;
+
 	typedef uint8 MapKey;
 	typedef float MapValue;
-	typedef TMap<EasySettings::MapKey, EasySettings::MapValue> FContainer;
+	typedef TStaticBitArray<VALUES_CAPACITY> FKeyBits;
+
+	/** Magic number at the start of every versioned container file ("ESET"). */
+	constexpr uint32 CONTAINER_MAGIC = 0x54455345;
+
+	/**
+	 * Versions of the container file format.
+	 *
+	 * Blocks are copied to and from memory as is, so the format is little-endian only, like every platform the engine
+	 * ships on. Byte-swapping archives are rejected.
+	 */
+	enum class EContainerVersion : uint16
+	{
+		/** Raw `VALUES_NUM` floats in key order, without any header. */
+		Headerless = 0,
+
+		/** Header with magic, version, value size, count, key layout and payload checksum. */
+		Initial = 1,
+
+		/** Adds the int, bool (bit-packed) and vector blocks after the float block, with their own checksum. */
+		Typed = 2,
+
+		/** Adds the named values: their name table followed by their float block. */
+		Named = 3,
+
+		/** Adds the bit-packed written flags of the float keys, with their own checksum. */
+		Written = 4,
+
+		/** Stores only the declared int, bool and vector keys: per type a count, the keys and their values. */
+		Sparse = 5,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	/** Kinds of records stored in the container journal. */
+	enum class EJournalRecord : uint8
+	{
+		/** A float value: the category key (`uint8`) followed by the value. */
+		Float = 1,
+
+		/** An int value: the category key (`uint8`) followed by an `int32`. */
+		Int = 2,
+
+		/** A bool value: the category key (`uint8`) followed by an `uint8`. */
+		Bool = 3,
+
+		/** A vector value: the category key (`uint8`) followed by four floats. */
+		Vector = 4,
+
+		/** A named value: the key name (`uint16` length and UTF-8 characters) followed by a float. */
+		Named = 5
+	};
+
+	/** Outcome of reading a container from memory. */
+	enum class EReadResult : uint8
+	{
+		/** The data is missing, truncated, corrupted or from a newer version. Defaults were loaded. */
+		Failed,
+
+		/** The data was loaded as is. */
+		Loaded,
+
+		/** The data was loaded from an older format or layout and should be written again. */
+		Migrated
+	};
+
+	/**
+	 * @brief Which keys have an int, bool or vector slot, and where it is.
+	 *
+	 * A key only gets a typed slot when it is declared with that type in the value schema, so each typed block holds
+	 * just the declared keys, in key order. Built once from the schema and shared by every container.
+	 */
+	struct EASYSETTINGS_API FTypedLayout
+	{
+		/** Marks a key without a slot of that type. */
+		static constexpr uint8 NO_SLOT = 0xFF;
+
+		uint8 IntSlots[VALUES_CAPACITY];
+		uint8 BoolSlots[VALUES_CAPACITY];
+		uint8 VectorSlots[VALUES_CAPACITY];
+
+		/** Declared keys of each type, in slot order. */
+		TArray<uint8> IntKeys;
+		TArray<uint8> BoolKeys;
+		TArray<uint8> VectorKeys;
+
+		FTypedLayout(const TArray<uint8>& InIntKeys, const TArray<uint8>& InBoolKeys, const TArray<uint8>& InVectorKeys);
+
+		FORCEINLINE int32 FindIntSlot(MapKey InKey) const { return ToSlot(IntSlots, InKey); }
+		FORCEINLINE int32 FindBoolSlot(MapKey InKey) const { return ToSlot(BoolSlots, InKey); }
+		FORCEINLINE int32 FindVectorSlot(MapKey InKey) const { return ToSlot(VectorSlots, InKey); }
+
+		/** The layout without any typed key, used until a schema is set. */
+		static const TSharedRef<const FTypedLayout>& GetEmpty();
+
+	private:
+		static FORCEINLINE int32 ToSlot(const uint8* InSlots, MapKey InKey)
+		{
+			return InKey < VALUES_NUM && InSlots[InKey] != NO_SLOT ? InSlots[InKey] : INDEX_NONE;
+		}
+	};
+
+	/**
+	 * @brief Storage for the categorized values.
+	 *
+	 * Keys are dense indices in `[0, VALUES_NUM)`, so every float value lives at its key in a fixed, aligned array.
+	 * A presence bitset tells which float slots hold a value, a written bitset which of them were ever set, so a stored
+	 * zero can be told apart from a slot that still needs its default.
+	 *
+	 * Int, bool and vector values are kept in their own blocks (struct-of-arrays) holding only the keys declared with
+	 * that type, see `FTypedLayout`. Declared slots default to zero; bools are packed one bit per slot.
+	 */
+	struct FContainer
+	{
+		alignas(16) MapValue Values[VALUES_CAPACITY];
+		FKeyBits Present;
+		FKeyBits Written;
+
+		/** Declared typed keys, the blocks below hold one value per declared key of their type. */
+		TSharedRef<const FTypedLayout> Layout;
+		TArray<int32> Ints;
+		TBitArray<> Bools;
+		TArray<FVector4f> Vectors;
+
+		FContainer()
+			: Layout(FTypedLayout::GetEmpty())
+		{
+			Empty();
+		}
+
+		/** Switches to another typed layout, the typed blocks are reset to zero. */
+		void SetLayout(const TSharedRef<const FTypedLayout>& InLayout)
+		{
+			Layout = InLayout;
+			EmptyTyped();
+		}
+
+		/** Removes all values. */
+		void Empty()
+		{
+			FMemory::Memzero(Values);
+			Present = FKeyBits();
+			Written = FKeyBits();
+			EmptyTyped();
+		}
+
+		/** Zero-fills the int, bool and vector blocks. */
+		void EmptyTyped()
+		{
+			Ints.Reset();
+			Ints.SetNumZeroed(Layout->IntKeys.Num());
+			Bools.Init(false, Layout->BoolKeys.Num());
+			Vectors.Reset();
+			Vectors.SetNumZeroed(Layout->VectorKeys.Num());
+		}
+
+		/** Fills every slot with zero and marks all `VALUES_NUM` keys as present. */
+		void Reset()
+		{
+			Empty();
+			for (int32 i = 0; i < VALUES_NUM; ++i)
+			{
+				Present[i] = true;
+			}
+		}
+
+		/** Checks whether a key is in range. */
+		static FORCEINLINE bool IsValidKey(MapKey InKey) { return InKey < VALUES_NUM; }
+
+		/** The int value of a key, or nullptr if the key is not declared as int. */
+		FORCEINLINE int32* FindInt(MapKey InKey)
+		{
+			const int32 slot = Layout->FindIntSlot(InKey);
+			return slot != INDEX_NONE ? &Ints[slot] : nullptr;
+		}
+
+		FORCEINLINE const int32* FindInt(MapKey InKey) const { return const_cast<FContainer*>(this)->FindInt(InKey); }
+
+		/** The vector value of a key, or nullptr if the key is not declared as vector. */
+		FORCEINLINE FVector4f* FindVector(MapKey InKey)
+		{
+			const int32 slot = Layout->FindVectorSlot(InKey);
+			return slot != INDEX_NONE ? &Vectors[slot] : nullptr;
+		}
+
+		FORCEINLINE const FVector4f* FindVector(MapKey InKey) const
+		{
+			return const_cast<FContainer*>(this)->FindVector(InKey);
+		}
+
+		FORCEINLINE bool Contains(MapKey InKey) const { return InKey < VALUES_NUM && Present[InKey]; }
+
+		FORCEINLINE const MapValue* Find(MapKey InKey) const { return Contains(InKey) ? &Values[InKey] : nullptr; }
+
+		/** Checks whether a float value was ever set for a key, by the game or in a loaded file. */
+		FORCEINLINE bool IsWritten(MapKey InKey) const { return Contains(InKey) && Written[InKey]; }
+
+		FORCEINLINE MapValue& operator[](MapKey InKey)
+		{
+			check(InKey < VALUES_NUM);
+			return Values[InKey];
+		}
+
+		FORCEINLINE const MapValue& operator[](MapKey InKey) const
+		{
+			check(InKey < VALUES_NUM);
+			return Values[InKey];
+		}
+
+		/** Raw pointer to the first slot. The block is `VALUES_CAPACITY` values long. */
+		FORCEINLINE MapValue* GetData() { return Values; }
+		FORCEINLINE const MapValue* GetData() const { return Values; }
+	};
 }
 
 
@@ -28,18 +249,68 @@ class EASYSETTINGS_API UEasySettingsSetter : public UObject
 
 protected:
 	/** 
-	 * @brief A map that stores float values categorized by an `uint8` key.
+	 * @brief Dense storage of float values categorized by an `uint8` key.
 	 * 
-	 * The map allows for fast retrieval and update of float values based on their category.
+	 * The key is used directly as the slot index, so retrieval and update are a single indexed access.
 	 */
 	EasySettings::FContainer Values;
+
+	/**
+	 * @brief The values as they were last read from or written to disk.
+	 *
+	 * Used to tell whether a key really differs from its persisted state.
+	 */
+	EasySettings::FContainer PersistedValues;
+
+	/** One bit per category, set while the value differs from `PersistedValues`. */
+	EasySettings::FKeyBits DirtyKeys;
+
+	/** Dirty bits of the int, bool and vector blocks. */
+	EasySettings::FKeyBits DirtyIntKeys;
+	EasySettings::FKeyBits DirtyBoolKeys;
+	EasySettings::FKeyBits DirtyVectorKeys;
+
+	/** Values of named keys, indexed by their slot in `FEasySettingsKeyRegistry`. Grows as keys are set. */
+	TArray<float> NamedValues;
+
+	/** Named values as they were last read from or written to disk. */
+	TArray<float> PersistedNamedValues;
+
+	/** One bit per named slot, set while the value differs from `PersistedNamedValues`. */
+	TBitArray<> DirtyNamedKeys;
+
+	/** One bit per category, set when the value changed since the last call to `ClearChangedKeys`. */
+	EasySettings::FKeyBits ChangedKeys;
+
+	/** Thread safe mirror that float value changes are published to, if any. */
+	TSharedPtr<FEasySettingsSharedValues, ESPMode::ThreadSafe> SharedValues;
+
+	/** Ranges values are validated against, if any. Owned by the subsystem. */
+	const FEasySettingsSchema* Schema = nullptr;
+
+	/**
+	 * @brief Outcome of the last `Read`, reported by `TryRead`.
+	 *
+	 * Overrides of `Read` that do not call the parent implementation can set it to report failures or migrations.
+	 */
+	EasySettings::EReadResult ReadResult = EasySettings::EReadResult::Failed;
+
+	/**
+	 * @brief Updates the dirty and changed bits of a category after its value has changed.
+	 *
+	 * Subclasses overriding `SetValue` without calling the parent implementation should call this to keep
+	 * dirty tracking correct.
+	 *
+	 * @param InCategory The category key (`uint8`) that was changed.
+	 */
+	void UpdateDirtyKey(uint8 InCategory);
 public:
 
 	/**
-	 * @brief Initializes the Values map with default float values.
+	 * @brief Initializes the Values container with default float values.
 	 * 
-	 * Clears the existing map, reserves space for the required number of categories (as defined by `VALUES_NUM`),
-	 * and initializes each category with a default value of 0.0f.
+	 * Zero-fills the storage for the required number of categories (as defined by `VALUES_NUM`)
+	 * and marks each category as present with a default value of 0.0f.
 	 * 
 	 * @note This method is intended to be overridden in Blueprints.
 	 */
@@ -49,7 +320,7 @@ public:
 	/**
 	 * @brief Sets the float value for a specific category.
 	 * 
-	 * If the provided category exists in the Values map, this method updates the associated float value.
+	 * If the provided category exists in the Values container, this method updates the associated float value.
 	 * If the category does not exist, no action is taken.
 	 * 
 	 * @param InCategory The category key (`uint8`) for which to set the value.
@@ -74,23 +345,329 @@ public:
 	UFUNCTION()
 	virtual bool GetValue(uint8 InCategory, float& OutValue);
 
+	/**
+	 * @brief Provides read-only access to all stored values.
+	 *
+	 * @return A const reference to the underlying container.
+	 */
+	const EasySettings::FContainer& GetValues() const { return Values; }
+
+	/**
+	 * @brief Provides a read-only view over all `VALUES_NUM` values, indexed by category.
+	 *
+	 * @return A view into the underlying storage. It stays valid for the lifetime of this object.
+	 */
+	TConstArrayView<float> GetValuesView() const { return MakeArrayView(Values.GetData(), EasySettings::VALUES_NUM); }
+
+	/**
+	 * @brief Sets the thread safe mirror that float value changes are published to, and publishes all values to it.
+	 *
+	 * Changes going through `UpdateDirtyKey` are published immediately. Call `PublishValues` after changing values
+	 * in bulk (reading, resetting).
+	 *
+	 * @param InSharedValues The mirror, or null to stop publishing.
+	 */
+	void SetSharedValues(TSharedPtr<FEasySettingsSharedValues, ESPMode::ThreadSafe> InSharedValues);
+
+	/** Publishes every float value to the shared mirror. */
+	void PublishValues();
+
+	/**
+	 * @brief Retrieves the values of several categories at once.
+	 *
+	 * Entries of `OutValues` whose category does not exist are left untouched.
+	 *
+	 * @param InCategories The category keys (`uint8`) to read.
+	 * @param OutValues Receives the values. Must be at least as long as `InCategories`.
+	 * @return The number of categories that were found.
+	 */
+	virtual int32 GetValues(TArrayView<const uint8> InCategories, TArrayView<float> OutValues) const;
+
+	/**
+	 * @brief Sets the values of several categories at once.
+	 *
+	 * If `SetValue` is implemented in Blueprints, it is still called once per value so the override sees every change.
+	 * Native subclasses overriding `SetValue_Implementation` should override this method as well.
+	 *
+	 * @param InCategories The category keys (`uint8`) to write.
+	 * @param InValues The values to assign. Must be at least as long as `InCategories`.
+	 */
+	virtual void SetValues(TArrayView<const uint8> InCategories, TArrayView<const float> InValues);
+
+	/**
+	 * @brief Sets the schema that set and loaded values are validated against.
+	 *
+	 * The schema also declares which categories have an int, bool or vector slot. Changing the layout resets the
+	 * typed values, so the schema is set before the container is read.
+	 *
+	 * @param InSchema The schema, must outlive this object. Null disables validation and typed slots.
+	 */
+	void SetSchema(const FEasySettingsSchema* InSchema);
+
+	/**
+	 * @brief Validates every float value against the schema in one sweep, e.g. after reading from disk.
+	 *
+	 * Repaired categories are marked dirty so the fixed values get saved, and are reported in the log.
+	 *
+	 * @return Number of repaired categories.
+	 */
+	int32 SanitizeValues();
+
+	/**
+	 * @brief Sets the int value of a category. Stored apart from the float value of the same category.
+	 *
+	 * Only categories declared as Int in the value schema have an int slot, others are ignored with a warning.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param InValue The value to assign.
+	 */
+	virtual void SetIntValue(uint8 InCategory, int32 InValue);
+
+	/**
+	 * @brief Retrieves the int value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to retrieve the value.
+	 * @param OutValue Receives the value.
+	 * @return true if the category is declared as Int.
+	 */
+	virtual bool GetIntValue(uint8 InCategory, int32& OutValue) const;
+
+	/**
+	 * @brief Sets the bool value of a category. Stored apart from the float value of the same category.
+	 *
+	 * Only categories declared as Bool in the value schema have a bool slot, others are ignored with a warning.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param bInValue The value to assign.
+	 */
+	virtual void SetBoolValue(uint8 InCategory, bool bInValue);
+
+	/**
+	 * @brief Retrieves the bool value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to retrieve the value.
+	 * @param bOutValue Receives the value.
+	 * @return true if the category is declared as Bool.
+	 */
+	virtual bool GetBoolValue(uint8 InCategory, bool& bOutValue) const;
+
+	/**
+	 * @brief Sets the vector value of a category. Stored apart from the float value of the same category.
+	 *
+	 * Only categories declared as Vector in the value schema have a vector slot, others are ignored with a warning.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param InValue The value to assign.
+	 */
+	virtual void SetVectorValue(uint8 InCategory, const FVector4f& InValue);
+
+	/**
+	 * @brief Retrieves the vector value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to retrieve the value.
+	 * @param OutValue Receives the value.
+	 * @return true if the category is declared as Vector.
+	 */
+	virtual bool GetVectorValue(uint8 InCategory, FVector4f& OutValue) const;
+
+	/**
+	 * @brief Sets the value of a named key.
+	 *
+	 * @param InSlot The slot of the key, see `FEasySettingsKey` and `FEasySettingsKeyRegistry`.
+	 * @param InValue The value to assign.
+	 */
+	virtual void SetNamedValue(int32 InSlot, float InValue);
+
+	/**
+	 * @brief Retrieves the value of a named key. Keys that were never set are 0.
+	 *
+	 * @param InSlot The slot of the key, see `FEasySettingsKey` and `FEasySettingsKeyRegistry`.
+	 * @param OutValue Receives the value.
+	 * @return true if the slot is registered.
+	 */
+	virtual bool GetNamedValue(int32 InSlot, float& OutValue) const;
+
+	/**
+	 * @brief Provides read-only access to the named values, indexed by slot.
+	 *
+	 * Slots past the end of the array have never been set.
+	 */
+	const TArray<float>& GetNamedValues() const { return NamedValues; }
+
+	/**
+	 * @brief Checks whether any value differs from the last persisted state.
+	 *
+	 * @return true if at least one category is dirty.
+	 */
+	bool IsDirty() const
+	{
+		return DirtyKeys.HasAnyBitsSet() || DirtyIntKeys.HasAnyBitsSet() || DirtyBoolKeys.HasAnyBitsSet()
+			|| DirtyVectorKeys.HasAnyBitsSet() || DirtyNamedKeys.Contains(true);
+	}
+
+	/**
+	 * @brief Checks whether a single category differs from the last persisted state.
+	 *
+	 * @param InCategory The category key (`uint8`) to check.
+	 * @return true if the category is dirty.
+	 */
+	bool IsKeyDirty(uint8 InCategory) const { return InCategory < EasySettings::VALUES_NUM && DirtyKeys[InCategory]; }
+
+	/**
+	 * @brief Checks whether a value was ever set for a category, as opposed to holding the zero it starts with.
+	 *
+	 * Containers written before the written flags were stored count every non-zero value as written.
+	 *
+	 * @param InCategory The category key (`uint8`) to check.
+	 * @return true if the category holds a set or loaded value.
+	 */
+	bool IsKeyWritten(uint8 InCategory) const { return Values.IsWritten(InCategory); }
+
+	/**
+	 * @brief Marks the current values as persisted and clears all dirty bits.
+	 */
+	virtual void MarkPersisted();
+
+	/**
+	 * @brief Provides the categories changed since the last call to `ClearChangedKeys`.
+	 *
+	 * Used to dispatch change notifications without scanning every value.
+	 */
+	const EasySettings::FKeyBits& GetChangedKeys() const { return ChangedKeys; }
+
+	/** Checks whether any category changed since the last call to `ClearChangedKeys`. */
+	bool HasChangedKeys() const { return ChangedKeys.HasAnyBitsSet(); }
+
+	/** Clears the changed bits of all categories. */
+	void ClearChangedKeys() { ChangedKeys = EasySettings::FKeyBits(); }
+
 	/**
 	 * @brief Reads and deserializes float values from a memory stream.
 	 * 
-	 * This method reads float values from the provided `FMemoryReader` and populates the Values map with these values.
-	 * It first calls `InitializeEmpty()` to ensure the map is properly initialized before reading.
+	 * This method reads float values from the provided `FMemoryReader` and populates the Values container with these values.
+	 * It first calls `InitializeEmpty()` to ensure the container is properly initialized before reading.
+	 * 
+	 * Versioned data is validated against its checksum. When the stored key layout matches the current one, the values
+	 * are copied in a single block; otherwise each stored key is mapped to its slot and unknown keys are dropped.
+	 * Headerless data written by older versions is still accepted and reported as `Migrated`.
+	 * The outcome is stored in `ReadResult`; on `Failed`, the container holds the defaults.
 	 * 
 	 * @param MemoryReader A reference to the `FMemoryReader` from which to read the data.
 	 */
 	virtual void Read(FMemoryReader& MemoryReader);
 
+	/**
+	 * @brief Reads the container through `Read` and reports how the data was read.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` from which to read the data.
+	 * @return The outcome of the read. Overrides of `Read` that do not set `ReadResult` are reported as `Loaded`.
+	 */
+	EasySettings::EReadResult TryRead(FMemoryReader& MemoryReader);
+
 	/**
 	 * @brief Writes and serializes the float values to a memory stream.
 	 * 
-	 * This method serializes the current values in the Values map and writes them to the provided `FMemoryWriter`.
-	 * It asserts that the number of elements in the map matches the expected number (`VALUES_NUM`).
+	 * This method writes the container header (magic, version, count, key layout and checksum)
+	 * followed by the values in key order as a single block, then the declared int, bool and vector keys
+	 * with their values, the named values with their name table and finally the written flags.
 	 * 
 	 * @param MemoryWriter A reference to the `FMemoryWriter` to which the data will be written.
 	 */
 	virtual void Write(FMemoryWriter& MemoryWriter);
+
+	/**
+	 * @brief Writes one journal record per dirty category to a memory stream.
+	 * 
+	 * The records are meant to be appended to the journal file next to the container, so a change to a single value
+	 * costs a few bytes instead of a full container write.
+	 * 
+	 * @param MemoryWriter A reference to the `FMemoryWriter` to which the records will be written.
+	 * @return The number of records written.
+	 */
+	virtual int32 WriteJournal(FMemoryWriter& MemoryWriter);
+
+	/**
+	 * @brief Applies journal records on top of the current values.
+	 * 
+	 * Records are applied in order, so the last record of a category wins. Reading stops at the first truncated
+	 * or unknown record. The resulting values are considered persisted.
+	 * 
+	 * @param MemoryReader A reference to the `FMemoryReader` from which to read the records.
+	 * @return The number of records applied.
+	 */
+	virtual int32 ReplayJournal(FMemoryReader& MemoryReader);
+
+protected:
+	/**
+	 * @brief Reads the versioned or headerless container format.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` positioned at the start of the data.
+	 * @return The outcome of the read.
+	 */
+	EasySettings::EReadResult ReadVersioned(FMemoryReader& MemoryReader);
+
+	/**
+	 * @brief Reads the headerless format used before the container was versioned.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` positioned at the start of the data.
+	 * @return true if enough data was available.
+	 */
+	bool ReadHeaderless(FMemoryReader& MemoryReader);
+
+	/**
+	 * @brief Reads the int, bool and vector blocks that follow the float block.
+	 *
+	 * Stored keys are mapped onto the declared slots, keys that are not declared with their type are dropped.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` positioned after the float block.
+	 * @param InVersion The version of the data, older versions store dense blocks indexed by key.
+	 * @return true if the blocks were complete and matched their checksum.
+	 */
+	bool ReadTyped(FMemoryReader& MemoryReader, uint16 InVersion);
+
+	/** Reads the dense typed blocks written before `EContainerVersion::Sparse`. */
+	bool ReadDenseTyped(FMemoryReader& MemoryReader);
+
+	/**
+	 * @brief Writes the declared int, bool and vector keys with their values.
+	 *
+	 * @param MemoryWriter A reference to the `FMemoryWriter` positioned after the float block.
+	 */
+	void WriteTyped(FMemoryWriter& MemoryWriter) const;
+
+	/**
+	 * @brief Reads the named values and maps each stored name onto its current slot.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` positioned after the typed blocks.
+	 * @return true if the section was complete and matched its checksum.
+	 */
+	bool ReadNamed(FMemoryReader& MemoryReader);
+
+	/**
+	 * @brief Writes the name table of the named values followed by their float block.
+	 *
+	 * @param MemoryWriter A reference to the `FMemoryWriter` positioned after the typed blocks.
+	 */
+	void WriteNamed(FMemoryWriter& MemoryWriter) const;
+
+	/**
+	 * @brief Reads the written flags of the float keys.
+	 *
+	 * @param MemoryReader A reference to the `FMemoryReader` positioned after the named values.
+	 * @return true if the flags were complete and matched their checksum.
+	 */
+	bool ReadWritten(FMemoryReader& MemoryReader);
+
+	/**
+	 * @brief Writes the written flags of the float keys.
+	 *
+	 * @param MemoryWriter A reference to the `FMemoryWriter` positioned after the named values.
+	 */
+	void WriteWritten(FMemoryWriter& MemoryWriter) const;
+
+	/** Derives the written flags of data stored without them: every non-zero float value counts as written. */
+	void MarkNonZeroWritten();
+
+	/** Grows the named value arrays to hold the given slot. */
+	void EnsureNamedSlot(int32 InSlot);
 };
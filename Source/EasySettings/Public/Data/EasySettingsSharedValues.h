@@ -0,0 +1,80 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/EasySettingsSetter.h"
+#include <atomic>
+
+/**
+ * @brief Thread safe mirror of the container float values.
+ *
+ * The game thread is the single writer: the setter publishes every value change here as it happens. Any thread (audio
+ * mixer, render thread, worker tasks) can read without marshalling to the game thread:
+ * - `GetValue` is wait-free, it reads a single atomic slot.
+ * - `GetValues` returns a consistent set of values. It is a sequence lock read, retried only while a publish is in
+ *   progress, and never blocks the game thread.
+ *
+ * Hold it through the shared reference returned by `UEasySettingsSubsystem::GetSharedContainerValues`; it outlives the
+ * subsystem, so a task never reads freed memory.
+ */
+class EASYSETTINGS_API FEasySettingsSharedValues
+{
+public:
+	FEasySettingsSharedValues();
+
+	FEasySettingsSharedValues(const FEasySettingsSharedValues&) = delete;
+	FEasySettingsSharedValues& operator=(const FEasySettingsSharedValues&) = delete;
+
+	/**
+	 * @brief Publishes every value and which categories are present. Game thread only.
+	 *
+	 * @param InValues The container to mirror.
+	 */
+	void Publish(const EasySettings::FContainer& InValues);
+
+	/**
+	 * @brief Publishes a single value. Game thread only.
+	 *
+	 * @param InCategory The category key (`uint8`), must be present in the last published container.
+	 * @param InValue The new value.
+	 */
+	void Publish(uint8 InCategory, float InValue);
+
+	/**
+	 * @brief Retrieves a value. Wait-free, safe from any thread.
+	 *
+	 * @param InCategory The category key (`uint8`).
+	 * @param OutValue Receives the value if the category is present.
+	 * @return true if the category is present.
+	 */
+	bool GetValue(uint8 InCategory, float& OutValue) const;
+
+	/**
+	 * @brief Retrieves several values as they were at the same point in time. Safe from any thread.
+	 *
+	 * @param InCategories Category keys to look up.
+	 * @param OutValues Receives the values, must be at least as long as `InCategories`. Missing keys are left untouched.
+	 * @return Number of categories found.
+	 */
+	int32 GetValues(TArrayView<const uint8> InCategories, TArrayView<float> OutValues) const;
+
+	/**
+	 * @brief Retrieves a number that changes with every publish. Safe from any thread.
+	 *
+	 * Readers can compare it with the last one they saw to skip re-reading values that did not change.
+	 */
+	uint32 GetVersion() const { return Sequence.load(std::memory_order_acquire) >> 1; }
+
+private:
+	static constexpr int32 PRESENT_WORDS = EasySettings::VALUES_CAPACITY / 32;
+
+	void BeginWrite();
+	void EndWrite();
+
+	/** Odd while a publish is in progress. */
+	std::atomic<uint32> Sequence;
+
+	std::atomic<float> Values[EasySettings::VALUES_CAPACITY];
+	std::atomic<uint32> PresentBits[PRESENT_WORDS];
+};
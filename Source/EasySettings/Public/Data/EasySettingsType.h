@@ -0,0 +1,36 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EasySettingsType.generated.h"
+
+/**
+ * ESettingsType
+ * 
+ * An enumeration representing different types of graphical settings in the game.
+ */
+UENUM(Blueprintable, BlueprintType)
+enum class ESettingsType : uint8
+{
+	/** Represents an invalid or uninitialized setting type. */
+	TYPE_NONE UMETA(Hidden),
+
+	/** Represents the Anti-Aliasing quality setting. */
+	TYPE_AA UMETA(DisplayName="Anti Aliasing"),
+
+	/** Represents the Texture quality setting. */
+	TYPE_Textures UMETA(DisplayName="Textures"),
+
+	/** Represents the Effects quality setting. */
+	TYPE_Effects UMETA(DisplayName="Effects"),
+
+	/** Represents the Details quality setting, including foliage, reflections, and other visual details. */
+	TYPE_Details UMETA(DisplayName="Details"),
+
+	/** Represents the Shadows quality setting. */
+	TYPE_Shadows UMETA(DisplayName="Shadows"),
+
+	/** Represents the maximum value for this enum, used internally. */
+	TYPE_MAX UMETA(Hidden)
+};
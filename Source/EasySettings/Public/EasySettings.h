@@ -5,6 +5,10 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+EASYSETTINGS_API DECLARE_LOG_CATEGORY_EXTERN(LogEasySettings, Log, All);
+
+class FEasySettingsContainerLoader;
+
 class FEasySettingsModule : public IModuleInterface
 {
 public:
@@ -12,4 +16,25 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+	static FEasySettingsModule& Get()
+	{
+		return FModuleManager::GetModuleChecked<FEasySettingsModule>("EasySettings");
+	}
+
+	/**
+	 * Hands over the container load started at module startup, if it targets the given file.
+	 * The load is handed over only once.
+	 */
+	TSharedPtr<FEasySettingsContainerLoader, ESPMode::ThreadSafe> TakePendingContainerLoad(const FString& InPath);
+
+private:
+	/**
+	 * Reads the container on the calling thread and pushes the persisted console variable settings and the scalability
+	 * groups, before the game viewport exists. The read is kept for the subsystem.
+	 */
+	void ApplyEarlySettings();
+
+	/** Container read kicked off at startup so the subsystem does not have to wait for disk I/O. */
+	TSharedPtr<FEasySettingsContainerLoader, ESPMode::ThreadSafe> PendingContainerLoad;
 };
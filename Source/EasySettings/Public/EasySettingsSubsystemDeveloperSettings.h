@@ -3,10 +3,125 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Data/EasySettingsType.h"
 
 #include "EasySettingsSubsystemDeveloperSettings.generated.h"
 
 class UEasySettingsSetter;
+class UWorld;
+
+/**
+ * EEasySettingsConsoleVariableType
+ * 
+ * The type a console variable setting is written as.
+ */
+UENUM(BlueprintType)
+enum class EEasySettingsConsoleVariableType : uint8
+{
+	/** Rounded to the nearest integer. */
+	Int UMETA(DisplayName="Int"),
+
+	/** Written as is. */
+	Float UMETA(DisplayName="Float"),
+
+	/** Zero is false, anything else is true. */
+	Bool UMETA(DisplayName="Bool")
+};
+
+/**
+ * EEasySettingsValueType
+ * 
+ * The block a container category is stored in.
+ */
+UENUM(BlueprintType)
+enum class EEasySettingsValueType : uint8
+{
+	Float UMETA(DisplayName="Float"),
+	Int UMETA(DisplayName="Int"),
+	Bool UMETA(DisplayName="Bool"),
+	Vector UMETA(DisplayName="Vector")
+};
+
+/**
+ * FEasySettingsConsoleVariableEntry
+ * 
+ * Declares a setting backed by a console variable, e.g. `r.ScreenPercentage`.
+ */
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsConsoleVariableEntry
+{
+	GENERATED_BODY()
+
+	/** Name used to look the setting up from code and Blueprints. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	FName Name;
+
+	/** The console variable to drive. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	FString ConsoleVariable;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	EEasySettingsConsoleVariableType Type = EEasySettingsConsoleVariableType::Float;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	float Min = 0.0f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	float Max = 1.0f;
+
+	/** Value used until the player changes the setting. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	float Default = 0.0f;
+
+	/** Store the value in the settings container and restore it on startup. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable")
+	bool bPersist = true;
+
+	/** Container category (`uint8`) the value is stored in. Must not be used by anything else. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variable", meta=(EditCondition="bPersist"))
+	uint8 ContainerKey = 0;
+};
+
+/**
+ * FEasySettingsValueSchemaEntry
+ * 
+ * Declares the type of a container category and, for float categories, its valid range. Loaded and set float values
+ * are clamped to it.
+ */
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsValueSchemaEntry
+{
+	GENERATED_BODY()
+
+	/** Container category (`uint8`) this entry describes. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Schema")
+	uint8 ContainerKey = 0;
+
+	/**
+	 * Every category has a float slot. Int, bool and vector slots only exist for the categories declared with that
+	 * type, so the container stores and copies just those.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Schema")
+	EEasySettingsValueType Type = EEasySettingsValueType::Float;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Schema",
+		meta=(EditCondition="Type == EEasySettingsValueType::Float"))
+	float Min = 0.0f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Schema",
+		meta=(EditCondition="Type == EEasySettingsValueType::Float"))
+	float Max = 1.0f;
+
+	/** Value of a new container, and replacement for NaN or infinite values. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Schema",
+		meta=(EditCondition="Type == EEasySettingsValueType::Float"))
+	float Default = 0.0f;
+
+	/** Values are snapped to `Min + N * Step`. 0 keeps them continuous. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Schema",
+		meta=(ClampMin="0", EditCondition="Type == EEasySettingsValueType::Float"))
+	float Step = 0.0f;
+};
 /**
  * 
  */
@@ -23,4 +138,148 @@ public:
 
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Container")
 	FString ContainerSaveName;
+
+	/** Compress and write the container on a background task instead of the game thread. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Container")
+	bool bAsyncContainerSave;
+
+	/**
+	 * Read and decompress the container on a background task, starting at module startup.
+	 * Accessing a container value before the load has finished blocks until it is done.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Container")
+	bool bAsyncContainerLoad;
+
+	/**
+	 * Read the container at module startup and push the persisted console variable settings and the scalability
+	 * groups right away, before the game viewport is created, so the first frames already render with the user
+	 * settings. The file is read on the calling thread and handed over to the subsystem, it is not read twice.
+	 * In the editor the scalability groups are left alone, the viewport keeps the editor scalability settings.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Container")
+	bool bApplySettingsEarly;
+
+	/**
+	 * Append changed values to a journal file instead of rewriting the whole container on every save.
+	 * The journal is merged into the container once it grows past `JournalCompactionThreshold`.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Container")
+	bool bJournalContainerChanges;
+
+	/** Journal size in bytes after which it is compacted into a full container save. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Container",
+		meta=(EditCondition="bJournalContainerChanges", ClampMin="64"))
+	int32 JournalCompactionThreshold;
+
+	/**
+	 * Settings backed by console variables. They are resolved once at startup into an indexed registry,
+	 * see `UEasySettingsSubsystem::FindConsoleVariableSetting`.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Console Variables", meta=(TitleProperty="Name"))
+	TArray<FEasySettingsConsoleVariableEntry> ConsoleVariableSettings;
+
+	/**
+	 * Types, ranges, defaults and steps of container categories. Float values are validated in one sweep when the
+	 * container is loaded and on bulk sets; categories without an entry only have NaN and infinite values replaced with
+	 * 0. Int, bool and vector values can only be stored for categories declared with that type.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category="Container", meta=(TitleProperty="ContainerKey"))
+	TArray<FEasySettingsValueSchemaEntry> ValueSchema;
+
+	/**
+	 * Run the engine hardware benchmark a few frames after startup and apply the detected settings on first launch.
+	 * The result is cached per machine; the benchmark only runs again when the hardware or graphics driver changes,
+	 * and is then only broadcast through `OnHardwareBenchmarkFinished`, never applied over the player choices.
+	 *
+	 * The benchmark renders on the game thread and hitches for a noticeable moment (longer with a higher
+	 * `AutoDetectWorkScale`). Make sure a loading screen or splash covers the first frames, or leave this off and call
+	 * `RunHardwareBenchmark` from a loading screen or the first-run menu instead.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Auto Detect")
+	bool bAutoDetectSettings;
+
+	/** Number of frames to wait after the subsystem initialization before benchmarking, e.g. until a loading screen is up. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Auto Detect",
+		meta=(EditCondition="bAutoDetectSettings", ClampMin="1"))
+	int32 AutoDetectDelayFrames;
+
+	/** Benchmark work scale, higher is more precise and slower. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Auto Detect",
+		meta=(EditCondition="bAutoDetectSettings", ClampMin="1", ClampMax="100"))
+	int32 AutoDetectWorkScale;
+
+	/** Maximum screen height per detected quality level (0 to 4), 0 for the desktop resolution. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Auto Detect", meta=(EditCondition="bAutoDetectSettings"))
+	TArray<int32> AutoDetectMaxResolutionHeights;
+
+	/** Frame rate limit per detected quality level (0 to 4), 0 for unlimited. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Auto Detect", meta=(EditCondition="bAutoDetectSettings"))
+	TArray<int32> AutoDetectFrameRateLimits;
+
+	/**
+	 * Lower settings groups while the frame time stays over budget, and raise them again once there is headroom.
+	 * Governed qualities are never saved; the user choices are restored when the governor steps back up or stops.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor")
+	bool bEnableQualityGovernor;
+
+	/**
+	 * Frame rate the governor tries to hold. A frame rate limit or VSync below it caps the budget, so a capped game is
+	 * never lowered to reach a rate it cannot display.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor",
+		meta=(EditCondition="bEnableQualityGovernor", ClampMin="1"))
+	float GovernorTargetFrameRate;
+
+	/** Frame time, relative to the budget, above which a frame counts as over budget. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor",
+		meta=(EditCondition="bEnableQualityGovernor", ClampMin="1"))
+	float GovernorOverBudgetRatio;
+
+	/** Frame time, relative to the budget, below which a frame has enough headroom to step back up. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor",
+		meta=(EditCondition="bEnableQualityGovernor", ClampMin="0.1", ClampMax="1"))
+	float GovernorHeadroomRatio;
+
+	/** Seconds the frame time has to stay over budget before a group is lowered. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor",
+		meta=(EditCondition="bEnableQualityGovernor", ClampMin="0.1"))
+	float GovernorStepDownSeconds;
+
+	/** Seconds the frame time has to stay below the headroom ratio before a group is raised again. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor",
+		meta=(EditCondition="bEnableQualityGovernor", ClampMin="0.1"))
+	float GovernorStepUpSeconds;
+
+	/** The governor never lowers a group below this quality. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor",
+		meta=(EditCondition="bEnableQualityGovernor", ClampMin="0", ClampMax="4"))
+	int32 GovernorMinQuality;
+
+	/** Groups in the order they are lowered, cheapest visual loss for the largest gain first. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Quality Governor", meta=(EditCondition="bEnableQualityGovernor"))
+	TArray<ESettingsType> GovernorStepOrder;
+
+	/**
+	 * Map the settings cost profiler runs on, e.g. a level that plays a camera flythrough sequence on begin play.
+	 * If empty, the profile runs on the current map.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Cost Profile", meta=(AllowedClasses="/Script/Engine.World"))
+	TSoftObjectPtr<UWorld> CostProfileMap;
+
+	/** Groups measured by the cost profiler, in order. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Cost Profile")
+	TArray<ESettingsType> CostProfileGroups;
+
+	/** Highest quality level measured, levels run from 0 to this value. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Cost Profile", meta=(ClampMin="0", ClampMax="4"))
+	int32 CostProfileMaxQuality;
+
+	/** Seconds ignored after each level is applied, while shaders, textures and streaming settle. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Cost Profile", meta=(ClampMin="0"))
+	float CostProfileWarmupSeconds;
+
+	/** Seconds each level is sampled for. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="Cost Profile", meta=(ClampMin="0.1"))
+	float CostProfileSampleSeconds;
 };
@@ -33,6 +33,47 @@ public:
 	UFUNCTION(BlueprintCallable, Category="UEasySettingsLib")
 	static FString GetContainerSaveName();
 
+	/**
+	 * @brief Retrieves the full path of the container save file.
+	 * 
+	 * Combines `GetConfigPath()` with `GetContainerSaveName()`, unless an override is set.
+	 * 
+	 * @return The container file path as a string.
+	 */
+	UFUNCTION(BlueprintCallable, Category="UEasySettingsLib")
+	static FString GetContainerSavePath();
+
+	/**
+	 * @brief Redirects the container and its journal to another file, e.g. a temporary one in automation tests.
+	 *
+	 * Only subsystems initialized afterwards use the new path.
+	 *
+	 * @param InPath The container file path, empty to use the configured one again.
+	 */
+	static void SetContainerSavePathOverride(const FString& InPath);
+
+	/**
+	 * @brief Retrieves the full path of the container journal file.
+	 * 
+	 * The journal sits next to the container file and holds changes appended since the last full save.
+	 * 
+	 * @return The journal file path as a string.
+	 */
+	UFUNCTION(BlueprintCallable, Category="UEasySettingsLib")
+	static FString GetContainerJournalPath();
+
+	/**
+	 * @brief Retrieves the full path of a settings profile file.
+	 * 
+	 * Profiles are stored in a `Profiles` folder next to the container file. The name is made a valid file name first,
+	 * so it cannot point outside that folder.
+	 * 
+	 * @param InName The profile name.
+	 * @return The profile file path as a string.
+	 */
+	UFUNCTION(BlueprintCallable, Category="UEasySettingsLib")
+	static FString GetSettingsProfilePath(FName InName);
+
 	/**
 	 * @brief Retrieves the developer settings for the Easy Settings subsystem.
 	 * 
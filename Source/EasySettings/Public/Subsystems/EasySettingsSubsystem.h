@@ -3,41 +3,123 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Containers/Ticker.h"
+#include "Data/EasySettingsConsoleVariable.h"
+#include "Data/EasySettingsConsoleVariableRegistry.h"
+#include "Data/EasySettingsCostProfile.h"
+#include "Data/EasySettingsEngineState.h"
+#include "Data/EasySettingsHardwareBenchmark.h"
+#include "Data/EasySettingsKey.h"
+#include "Data/EasySettingsProfile.h"
+#include "Data/EasySettingsSchema.h"
 #include "Data/EasySettingsSetter.h"
+#include "Data/EasySettingsSharedValues.h"
+#include "Data/EasySettingsType.h"
 #include "GameFramework/GameUserSettings.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "EasySettingsSubsystem.generated.h"
 
+class FEasySettingsContainerLoader;
+class FEasySettingsContainerWriter;
+struct FDisplayMetrics;
+
+/**
+ * Called on the game thread after a container save attempt finishes.
+ *
+ * @param bSuccess True if the container file was written.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEasySettingsContainerSaved, bool, bSuccess);
+
+/** Called on the game thread once the container has been loaded. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEasySettingsContainerLoaded);
+
+/** Called when the display configuration changed and the supported resolutions must be queried again. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEasySettingsResolutionsChanged);
+
+/**
+ * Called after the hardware benchmark has run.
+ *
+ * @param Result The benchmark result.
+ * @param bApplied True if the detected settings were applied.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEasySettingsHardwareBenchmarkFinished,
+                                             const FEasySettingsHardwareBenchmark&, Result, bool, bApplied);
+
 /**
- * ESettingsType
+ * Called when the quality governor lowers or raises a settings group.
+ *
+ * @param SettingsType The group that changed.
+ * @param Quality The new quality of the group.
+ * @param FrameTimeMs The smoothed frame time that triggered the change, in milliseconds.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnEasySettingsQualityGoverned, ESettingsType, SettingsType, int32, Quality,
+                                               float, FrameTimeMs);
+
+/**
+ * Called after the settings cost profiler has measured every group and quality level.
+ *
+ * @param Samples One sample per measured group and quality level.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEasySettingsCostProfileFinished, const TArray<FEasySettingsCostSample>&,
+                                            Samples);
+
+/**
+ * FEasySettingsValueChange
  * 
- * An enumeration representing different types of graphical settings in the game.
+ * A single container value change, as dispatched to change listeners.
  */
-UENUM(Blueprintable, BlueprintType)
-enum class ESettingsType : uint8
+USTRUCT(BlueprintType)
+struct EASYSETTINGS_API FEasySettingsValueChange
 {
-	/** Represents an invalid or uninitialized setting type. */
-	TYPE_NONE UMETA(Hidden),
+	GENERATED_BODY()
 
-	/** Represents the Anti-Aliasing quality setting. */
-	TYPE_AA UMETA(DisplayName="Anti Aliasing"),
+	/** The category key (`uint8`) that changed. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Container")
+	uint8 Category = 0;
 
-	/** Represents the Texture quality setting. */
-	TYPE_Textures UMETA(DisplayName="Textures"),
+	/** The block that changed, a category declared with a type can report a float and a typed change. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Container")
+	EEasySettingsValueType Type = EEasySettingsValueType::Float;
 
-	/** Represents the Effects quality setting. */
-	TYPE_Effects UMETA(DisplayName="Effects"),
+	/** The new float value of the category. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Container")
+	float Value = 0.0f;
 
-	/** Represents the Details quality setting, including foliage, reflections, and other visual details. */
-	TYPE_Details UMETA(DisplayName="Details"),
+	/** The new int value, for `Int` changes. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Container")
+	int32 IntValue = 0;
 
-	/** Represents the Shadows quality setting. */
-	TYPE_Shadows UMETA(DisplayName="Shadows"),
+	/** The new bool value, for `Bool` changes. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Container")
+	bool bBoolValue = false;
 
-	/** Represents the maximum value for this enum, used internally. */
-	TYPE_MAX UMETA(Hidden)
+	/** The new vector value, for `Vector` changes. */
+	UPROPERTY(BlueprintReadOnly, Category="GameSettingsSubsystem|Container")
+	FVector4 VectorValue = FVector4(0.0f, 0.0f, 0.0f, 0.0f);
 };
 
+/** Native listener for container value changes within a key range. Called once per frame at most. */
+DECLARE_DELEGATE_OneParam(FEasySettingsValuesChangedDelegate, TConstArrayView<FEasySettingsValueChange>);
+
+/** Native listener for a settings group quality change. Called once per frame at most. */
+DECLARE_DELEGATE_TwoParams(FEasySettingsGroupChangedDelegate, ESettingsType, int32);
+
+/**
+ * Blueprint listener for container value changes within a key range.
+ *
+ * @param Changes The changed values, last value wins when a category changed several times in a frame.
+ */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnEasySettingsValuesChanged, const TArray<FEasySettingsValueChange>&, Changes);
+
+/**
+ * Blueprint listener for a settings group quality change.
+ *
+ * @param SettingsType The group that changed.
+ * @param Quality The new quality level of the group.
+ */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnEasySettingsGroupChanged, ESettingsType, SettingsType, int32, Quality);
+
 /**
  * UEasySettingsSubsystem
  * 
@@ -52,10 +134,294 @@ class EASYSETTINGS_API UEasySettingsSubsystem : public UGameInstanceSubsystem
 protected:
 	UPROPERTY()
 	UEasySettingsSetter* SettingsSetter;
+
+	/** Number of currently open settings batches. Applies are deferred while greater than zero. */
+	int32 BatchDepth;
+
+	/** True if an apply was requested while a batch was open. */
+	bool bBatchApplyRequested;
+
+	/** True if any open batch was cancelled; the outermost batch will roll back instead of applying. */
+	bool bBatchRollbackRequested;
+
+	/** Engine settings captured when the outermost batch was opened. */
+	FEasySettingsEngineState BatchEngineSnapshot;
+
+	/** Container values captured when the outermost batch was opened. */
+	EasySettings::FContainer BatchContainerSnapshot;
+
+	/** Named values captured when the outermost batch was opened. */
+	TArray<float> BatchNamedSnapshot;
+
+	/** Engine settings as they were last applied and written to the user config. */
+	FEasySettingsEngineState AppliedEngineState;
+
+	/** Background writer used to persist container snapshots. */
+	TSharedPtr<FEasySettingsContainerWriter, ESPMode::ThreadSafe> ContainerWriter;
+
+	/** Background read of the container file, valid until the load has been finished on the game thread. */
+	TSharedPtr<FEasySettingsContainerLoader, ESPMode::ThreadSafe> PendingContainerLoad;
+
+	/** Polls `PendingContainerLoad` once per frame. */
+	FTSTicker::FDelegateHandle ContainerLoadTickerHandle;
+
+	/** True once the container values have been read (or initialized to defaults). */
+	bool bContainerLoaded;
+
+	/** Size in bytes of the journal appended since the last full container save. */
+	int64 ContainerJournalSize;
+
+	/** True if no container file existed when the container was loaded, i.e. on first launch. */
+	bool bContainerCreated;
+
+	/** Waits for `AutoDetectFrame` before running the automatic settings detection. */
+	FTSTicker::FDelegateHandle AutoDetectTickerHandle;
+	uint64 AutoDetectFrame;
+
+	/** A listener for a range of container keys. */
+	struct FContainerListener
+	{
+		uint8 First = 0;
+		uint8 Last = 0;
+		FDelegateHandle Handle;
+		FEasySettingsValuesChangedDelegate Native;
+		FOnEasySettingsValuesChanged Dynamic;
+	};
+
+	/** A listener for a settings group. */
+	struct FGroupListener
+	{
+		ESettingsType SettingsType = ESettingsType::TYPE_NONE;
+		FDelegateHandle Handle;
+		FEasySettingsGroupChangedDelegate Native;
+		FOnEasySettingsGroupChanged Dynamic;
+	};
+
+	TArray<FContainerListener> ContainerListeners;
+	TArray<FGroupListener> GroupListeners;
+
+	/** Container values as they were last dispatched to listeners. */
+	EasySettings::FContainer DispatchedContainerValues;
+
+	/** Group qualities as they were last dispatched to listeners, indexed by `ESettingsType`. */
+	TStaticArray<int32, static_cast<int32>(ESettingsType::TYPE_MAX)> DispatchedGroupQualities;
+
+	FDelegateHandle EndFrameHandle;
+
+	/** Cached handle of `r.AntiAliasingMethod`. */
+	FEasySettingsConsoleVariable AntiAliasingMethodVariable;
+
+	/** Cached handle of `r.VSync`. */
+	FEasySettingsConsoleVariable VSyncVariable;
+
+	/** Samples the frame time while the quality governor is enabled. */
+	FTSTicker::FDelegateHandle GovernorTickerHandle;
+
+	/** Smoothed work time of the bottleneck (game thread, render thread or GPU) in seconds. */
+	float GovernorFrameTime;
+
+	/** Seconds the smoothed frame time has been over budget, or below the headroom ratio. */
+	float GovernorOverBudgetTime;
+	float GovernorHeadroomTime;
+
+	/** Groups lowered by the governor, one entry per step, most recent last. */
+	TArray<ESettingsType> GovernorSteps;
+
+	/** The user choices, captured before the governor lowered the first group. */
+	FEasySettingsEngineState GovernorUserState;
+
+	/** Quality the governor last set, indexed by `ESettingsType`. */
+	TStaticArray<int32, static_cast<int32>(ESettingsType::TYPE_MAX)> GovernorQualities;
+
+	/** Steps through the quality levels while the cost profiler runs. */
+	FTSTicker::FDelegateHandle CostProfileTickerHandle;
+
+	/** Waits for the configured map before the sweep starts. */
+	FDelegateHandle CostProfileMapLoadedHandle;
+	bool bCostProfileMapOpened;
+
+	/** Groups still to be measured, the current one first. */
+	TArray<ESettingsType> CostProfileGroups;
+	int32 CostProfileQuality;
+
+	/** Seconds since the current level was applied. */
+	float CostProfileStepTime;
+
+	/** Sums of the frames sampled at the current level, averaged once the window ends. */
+	FEasySettingsCostSample CostProfileAccumulator;
+
+	TArray<FEasySettingsCostSample> CostProfileSamples;
+
+	/** The user choices, restored after each group and when the profile ends. */
+	FEasySettingsEngineState CostProfileUserState;
+
+	/** The governor is paused while measuring, it would fight the sweep. */
+	bool bCostProfileGovernorWasEnabled;
+
+	/** Set when started from the command line; the application exits once the tables are written. */
+	bool bQuitAfterCostProfile;
+
+	/** Console variable settings declared in the developer settings, resolved once on initialization. */
+	FEasySettingsConsoleVariableRegistry ConsoleVariableRegistry;
+
+	/** Ranges container values are validated against, built once on initialization. */
+	FEasySettingsSchema ValueSchema;
+
+	/** Thread safe mirror of the container values, survives container reloads. */
+	TSharedPtr<FEasySettingsSharedValues, ESPMode::ThreadSafe> SharedContainerValues;
+
+	/** Supported resolutions of a window mode, grouped by aspect ratio. */
+	struct FResolutionList
+	{
+		bool bValid = false;
+
+		/** Sorted by width, then height, without duplicates. */
+		TArray<FIntPoint> Resolutions;
+
+		/** Distinct aspect ratios of `Resolutions`, in order of first appearance. */
+		TArray<FIntPoint> AspectRatios;
+
+		/** Index into `AspectRatios` of each resolution. */
+		TArray<int32> AspectRatioIndices;
+	};
+
+	/** Display modes are enumerated through the platform layer, so the lists are kept until the displays change. */
+	mutable FResolutionList WindowedResolutions;
+	mutable FResolutionList FullscreenResolutions;
+
+	/** Refresh rates of each fullscreen resolution, sorted ascending. */
+	mutable TMap<FIntPoint, TArray<uint32>> RefreshRates;
+	mutable bool bRefreshRatesValid;
+
+	FDelegateHandle DisplayMetricsChangedHandle;
+public:
+	/** Broadcast on the game thread every time a container save finishes. */
+	UPROPERTY(BlueprintAssignable, Category="GameSettingsSubsystem|Container")
+	FOnEasySettingsContainerSaved OnContainerSaved;
+
+	/**
+	 * Broadcast on the game thread once the container has been loaded.
+	 * Check `IsContainerLoaded()` before binding, the load may already be finished.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="GameSettingsSubsystem|Container")
+	FOnEasySettingsContainerLoaded OnContainerLoaded;
+
+	/** Broadcast after the displays changed, the supported resolution lists have been invalidated. */
+	UPROPERTY(BlueprintAssignable, Category="GameSettingsSubsystem|Window")
+	FOnEasySettingsResolutionsChanged OnSupportedResolutionsChanged;
+
+	/** Broadcast every time the quality governor lowers or raises a settings group. */
+	UPROPERTY(BlueprintAssignable, Category="GameSettingsSubsystem|Quality Governor")
+	FOnEasySettingsQualityGoverned OnQualityGoverned;
+
+	/** Broadcast once the settings cost profiler has measured every configured group and written its tables. */
+	UPROPERTY(BlueprintAssignable, Category="GameSettingsSubsystem|Cost Profile")
+	FOnEasySettingsCostProfileFinished OnSettingsCostProfileFinished;
+
+	/** Broadcast after the hardware benchmark has run, automatically or through `RunHardwareBenchmark`. */
+	UPROPERTY(BlueprintAssignable, Category="GameSettingsSubsystem|Auto Detect")
+	FOnEasySettingsHardwareBenchmarkFinished OnHardwareBenchmarkFinished;
 protected:
-	void SaveContainer();
+	void SaveContainer(bool bFullSnapshot = false);
+	void AppendContainerJournal();
+	void EndSettingsBatch();
+	void RollbackSettingsBatch();
 	void InitContainer();
+	void ReadContainer(bool bFileExists, bool bReadSucceeded, const TArray<uint8>& InBytes,
+	                   const TArray<uint8>& InJournalBytes);
+	void FinishContainerLoad();
+	bool PollContainerLoad(float InDeltaTime);
+
+	const FResolutionList& GetResolutionList(EWindowMode::Type InWindowMode) const;
+	void HandleDisplayMetricsChanged(const FDisplayMetrics& InMetrics);
+
+	/**
+	 * Finishes a pending container load, blocking if the background read is still running.
+	 *
+	 * @return True if the container exists.
+	 */
+	bool EnsureContainerLoaded();
 	FString GetContainerSavePath();
+
+	/** Sends the changes collected during the frame to listeners. Runs at the end of every frame. */
+	void DispatchSettingsChanges();
+	void DispatchContainerChanges();
+	void DispatchGroupChanges();
+	void ResetDispatchedState();
+
+	/**
+	 * Applies the given categories of the current engine settings with the narrowest engine calls. `Display` has no
+	 * narrow call, `ApplySettings` falls back to the full engine apply for it.
+	 *
+	 * @param InChanges The categories that differ from the last applied state.
+	 */
+	void ApplyEngineChanges(EEasySettingsEngineChange InChanges);
+
+	bool TickQualityGovernor(float InDeltaTime);
+	bool StepQualityDown();
+	bool StepQualityUp();
+
+	/** Puts the user choices back into `UGameUserSettings` before they are applied and saved. */
+	void RestoreGovernedQualities();
+
+	/**
+	 * Lowers the governed groups again after `RestoreGovernedQualities`.
+	 *
+	 * @param bApplyEngine If true, the scalability groups are applied to the engine as well.
+	 */
+	void ReapplyGovernedQualities(bool bApplyEngine);
+
+	/**
+	 * Runs once `AutoDetectFrame` has been reached. Applies the cached benchmark result on first launch
+	 * and runs the benchmark again if there is no result for this machine.
+	 */
+	bool PollAutoDetect(float InDeltaTime);
+
+	void HandleCostProfileMapLoaded(UWorld* InWorld);
+	void BeginCostProfileSweep();
+	bool TickCostProfile(float InDeltaTime);
+
+	/**
+	 * Moves the sweep to the next quality level, or to the next group once the current one is done.
+	 *
+	 * @return False if every group has been measured.
+	 */
+	bool AdvanceCostProfile();
+
+	/**
+	 * Restores the user settings and stops the sweep.
+	 *
+	 * @param bCompleted If true, the cost tables are written and `OnSettingsCostProfileFinished` is broadcast.
+	 */
+	void FinishCostProfile(bool bCompleted);
+
+	/**
+	 * Puts the user choice of the measured group back into `UGameUserSettings` before it is applied and saved.
+	 *
+	 * @return True if a sweep is measuring a level, `ReapplyCostProfileLevel` has to be called after the apply.
+	 */
+	bool RestoreCostProfileLevel();
+
+	/**
+	 * Sets the measured level again after `RestoreCostProfileLevel`.
+	 *
+	 * @param InChanges What the apply pushed to the engine, the measured level and the suspended limits are
+	 * pushed again where needed.
+	 */
+	void ReapplyCostProfileLevel(EEasySettingsEngineChange InChanges);
+
+	/** Turns VSync and the frame rate limit off while the sweep measures, `UGameUserSettings` keeps the user values. */
+	void SuspendFrameRateLimits();
+
+	/**
+	 * Stores the schema and console variable setting defaults for every key that was never written.
+	 *
+	 * @return The number of keys that got their default.
+	 */
+	int32 SeedContainerDefaults();
+
+	/** Pushes the persisted values of the console variable settings to their console variables. */
+	void RestoreConsoleVariableSettings();
 public:
 
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
@@ -84,7 +450,9 @@ public:
 	/**
 	* Sets the Anti-Aliasing method.
 	* 
-	* @param InController The player controller that will execute the command.
+	* Writes `r.AntiAliasingMethod` directly through a cached console variable handle.
+	* 
+	* @param InController Unused, kept for compatibility. The method can be set without a player controller.
 	* @param InValue The method index (typically 0 to 4).
 	* @param bApply Whether to immediately apply the setting.
 	*/
@@ -279,6 +647,61 @@ public:
 	void GetSupportedResolutions(TArray<FIntPoint>& OutResult,
 	                             TEnumAsByte<EWindowMode::Type> InWindowMode = EWindowMode::Type::Windowed);
 
+	/**
+	 * @brief Retrieves the cached supported resolutions of a window mode without copying them.
+	 *
+	 * The list is sorted by width, then height, and has no duplicates. The view stays valid until the displays change
+	 * (see `OnSupportedResolutionsChanged`).
+	 *
+	 * @param InWindowMode The window mode to consider (windowed or fullscreen).
+	 * @return View of the supported resolutions.
+	 */
+	TConstArrayView<FIntPoint> GetSupportedResolutionsView(EWindowMode::Type InWindowMode = EWindowMode::Windowed) const;
+
+	/**
+	 * @brief Retrieves the distinct aspect ratios of the supported resolutions, e.g. (16, 9).
+	 *
+	 * Resolutions within 3% of a common ratio (1366x768 or 2560x1080 for instance) are grouped under it.
+	 *
+	 * @param InWindowMode The window mode to consider (windowed or fullscreen).
+	 * @return View of the aspect ratios, valid until the displays change.
+	 */
+	TConstArrayView<FIntPoint> GetSupportedAspectRatiosView(EWindowMode::Type InWindowMode = EWindowMode::Windowed) const;
+
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Window")
+	void GetSupportedAspectRatios(TArray<FIntPoint>& OutResult,
+	                              TEnumAsByte<EWindowMode::Type> InWindowMode = EWindowMode::Type::Windowed) const;
+
+	/**
+	 * Retrieves the supported resolutions that have the given aspect ratio.
+	 *
+	 * @param OutResult An array that will be filled with the matching resolutions, sorted.
+	 * @param InAspectRatio An aspect ratio returned by `GetSupportedAspectRatios`.
+	 * @param InWindowMode The window mode to consider (windowed or fullscreen).
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Window")
+	void GetSupportedResolutionsForAspectRatio(TArray<FIntPoint>& OutResult, FIntPoint InAspectRatio,
+	                                           TEnumAsByte<EWindowMode::Type> InWindowMode =
+		                                           EWindowMode::Type::Windowed) const;
+
+	/**
+	 * @brief Retrieves the refresh rates the displays support at a fullscreen resolution.
+	 *
+	 * @param InResolution A supported fullscreen resolution.
+	 * @return View of the refresh rates in Hz, sorted ascending. Empty if the resolution is unknown.
+	 */
+	TConstArrayView<uint32> GetSupportedRefreshRatesView(FIntPoint InResolution) const;
+
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Window")
+	void GetSupportedRefreshRates(TArray<int32>& OutResult, FIntPoint InResolution) const;
+
+	/**
+	 * Drops the cached resolution lists, they are queried again on next access.
+	 * Called automatically when the displays change.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Window")
+	void InvalidateSupportedResolutions();
+
 	/**
 	 * @brief Sets the container value for a specific category.
 	 *
@@ -307,12 +730,590 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
 	bool GetContainerValue(uint8 InCategory, float& OutValue);
+
+	/**
+	 * @brief Sets the int value of a category.
+	 *
+	 * Int, bool and vector values are stored in their own blocks, apart from the float value of the same category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	void SetContainerInt(uint8 InCategory, int32 InValue, bool bApply = true);
+
+	/**
+	 * @brief Retrieves the int value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to get the value.
+	 * @param OutValue A reference to store the retrieved value.
+	 * @return true if the value was successfully retrieved; false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	bool GetContainerInt(uint8 InCategory, int32& OutValue);
+
+	/**
+	 * @brief Sets the bool value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param bInValue The value to set.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	void SetContainerBool(uint8 InCategory, bool bInValue, bool bApply = true);
+
+	/**
+	 * @brief Retrieves the bool value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to get the value.
+	 * @param bOutValue A reference to store the retrieved value.
+	 * @return true if the value was successfully retrieved; false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	bool GetContainerBool(uint8 InCategory, bool& bOutValue);
+
+	/**
+	 * @brief Sets the vector value of a category, e.g. a resolution or a color.
+	 *
+	 * The value is stored with single precision.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	void SetContainerVector(uint8 InCategory, FVector4 InValue, bool bApply = true);
+
+	/**
+	 * @brief Retrieves the vector value of a category.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to get the value.
+	 * @param OutValue A reference to store the retrieved value.
+	 * @return true if the value was successfully retrieved; false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	bool GetContainerVector(uint8 InCategory, FVector4& OutValue);
+
+	/**
+	 * @brief Sets an enum value of a category, stored in the int block.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to set the value.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	template <typename EnumType>
+	void SetContainerEnum(uint8 InCategory, EnumType InValue, bool bApply = true)
+	{
+		static_assert(TIsEnum<EnumType>::Value, "SetContainerEnum expects an enum type");
+		SetContainerInt(InCategory, static_cast<int32>(InValue), bApply);
+	}
+
+	/**
+	 * @brief Retrieves an enum value of a category, stored in the int block.
+	 *
+	 * @param InCategory The category key (`uint8`) for which to get the value.
+	 * @param InDefault Returned if the value could not be retrieved.
+	 * @return The stored value.
+	 */
+	template <typename EnumType>
+	EnumType GetContainerEnum(uint8 InCategory, EnumType InDefault)
+	{
+		static_assert(TIsEnum<EnumType>::Value, "GetContainerEnum expects an enum type");
+		int32 value;
+		return GetContainerInt(InCategory, value) ? static_cast<EnumType>(value) : InDefault;
+	}
+
+	/**
+	 * @brief Maps a setting name to its slot, registering it if needed.
+	 *
+	 * Names are case-sensitive and not limited in number. The slot stays valid for the lifetime of the process,
+	 * so it can be cached and used with `SetNamedValueBySlot` and `GetNamedValueBySlot` without any name lookup.
+	 *
+	 * @param InName The setting name.
+	 * @return The slot, or -1 if the name is empty.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Container")
+	int32 ResolveNamedSetting(FName InName) const;
+
+	/**
+	 * @brief Sets the value of a named setting.
+	 *
+	 * @param InSlot The slot returned by `ResolveNamedSetting`.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container", meta=(DisplayName="Set Named Value"))
+	void SetNamedValueBySlot(int32 InSlot, float InValue, bool bApply = true);
+
+	/**
+	 * @brief Retrieves the value of a named setting. Settings that were never set are 0.
+	 *
+	 * @param InSlot The slot returned by `ResolveNamedSetting`.
+	 * @param OutValue A reference to store the retrieved value.
+	 * @return true if the slot is registered.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container", meta=(DisplayName="Get Named Value"))
+	bool GetNamedValueBySlot(int32 InSlot, float& OutValue);
+
+	/**
+	 * @brief Sets the value of a named setting.
+	 *
+	 * @param InKey The key, resolved to its slot on first use.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings immediately after setting the value.
+	 */
+	void SetNamedValue(const FEasySettingsKey& InKey, float InValue, bool bApply = true)
+	{
+		SetNamedValueBySlot(InKey.GetSlot(), InValue, bApply);
+	}
+
+	/**
+	 * @brief Retrieves the value of a named setting.
+	 *
+	 * @param InKey The key, resolved to its slot on first use.
+	 * @param OutValue A reference to store the retrieved value.
+	 * @return true if the value was successfully retrieved; false otherwise.
+	 */
+	bool GetNamedValue(const FEasySettingsKey& InKey, float& OutValue)
+	{
+		return GetNamedValueBySlot(InKey.GetSlot(), OutValue);
+	}
+
+	/**
+	 * @brief Retrieves the values of several categories at once.
+	 *
+	 * Performs a single validity check and no per-value virtual calls.
+	 * Entries of `OutValues` whose category does not exist are left untouched.
+	 *
+	 * @param InCategories The category keys (`uint8`) to read.
+	 * @param OutValues Receives the values. Must be at least as long as `InCategories`.
+	 * @return The number of categories that were found.
+	 */
+	int32 GetContainerValues(TArrayView<const uint8> InCategories, TArrayView<float> OutValues);
+
+	/**
+	 * @brief Sets the values of several categories at once.
+	 *
+	 * If the `bApply` flag is true, the settings are applied and saved once after all values have been set.
+	 *
+	 * @param InCategories The category keys (`uint8`) to write.
+	 * @param InValues The values to assign. Must be at least as long as `InCategories`.
+	 * @param bApply If true, applies the settings once after setting the values.
+	 */
+	void SetContainerValues(TArrayView<const uint8> InCategories, TArrayView<const float> InValues, bool bApply = true);
+
+	/**
+	 * @brief Provides direct read access to the container storage, as used by `TEasySetting` handles.
+	 *
+	 * Finishes a pending load first. The storage keeps its address until the subsystem is deinitialized.
+	 * Game thread only, other threads use `GetSharedContainerValues`.
+	 *
+	 * @return The container, or null if it does not exist.
+	 */
+	const EasySettings::FContainer* GetContainerStorage();
+
+	/**
+	 * @brief Provides thread safe read access to the container float values.
+	 *
+	 * Keep the reference and read from any thread (audio, render, worker tasks) without going through the game thread.
+	 * Values are published as they change; until the container has loaded, no category is present.
+	 *
+	 * @return The shared mirror of the container values.
+	 */
+	TSharedRef<const FEasySettingsSharedValues, ESPMode::ThreadSafe> GetSharedContainerValues() const;
+
+	/**
+	 * @brief Provides a read-only view over all container values, indexed by category.
+	 *
+	 * @return A view into the container storage, or an empty view if the container does not exist.
+	 */
+	TConstArrayView<float> GetAllContainerValues();
+
+	/**
+	 * @brief Retrieves the values of several categories at once.
+	 *
+	 * @param InCategories The category keys (`uint8`) to read.
+	 * @param OutValues Receives one value per category; missing categories are reported as 0.
+	 * @return true if every category was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container", meta=(DisplayName="Get Container Values"))
+	bool GetContainerValuesArray(const TArray<uint8>& InCategories, TArray<float>& OutValues);
+
+	/**
+	 * @brief Sets the values of several categories at once and applies them once.
+	 *
+	 * @param InCategories The category keys (`uint8`) to write.
+	 * @param InValues The values to assign, one per category.
+	 * @param bApply If true, applies the settings once after setting the values.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container", meta=(DisplayName="Set Container Values"))
+	void SetContainerValuesArray(const TArray<uint8>& InCategories, const TArray<float>& InValues, bool bApply = true);
+
+	/**
+	 * @brief Copies all container values, indexed by category.
+	 *
+	 * @param OutValues Receives `VALUES_NUM` values.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container", meta=(DisplayName="Get All Container Values"))
+	void GetAllContainerValuesArray(TArray<float>& OutValues);
+
+	/**
+	 * @brief Finds a console variable setting declared in the developer settings.
+	 *
+	 * The returned index stays valid for the lifetime of the subsystem, so it can be cached and used with
+	 * `GetConsoleVariableSetting` and `SetConsoleVariableSetting` without any name lookup.
+	 *
+	 * @param InName The setting name.
+	 * @return The setting index, or -1 if the setting is not declared.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Console Variables")
+	int32 FindConsoleVariableSetting(FName InName) const { return ConsoleVariableRegistry.FindIndex(InName); }
+
+	/**
+	 * @brief Retrieves the number of console variable settings.
+	 *
+	 * @return The number of valid setting indices.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Console Variables")
+	int32 GetConsoleVariableSettingsNum() const { return ConsoleVariableRegistry.Num(); }
+
+	/**
+	 * @brief Retrieves the current value of a console variable setting.
+	 *
+	 * @param InIndex The setting index returned by `FindConsoleVariableSetting`.
+	 * @return The console variable value, or 0 if the index is invalid.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Console Variables")
+	float GetConsoleVariableSetting(int32 InIndex) const;
+
+	/**
+	 * @brief Sets the value of a console variable setting.
+	 *
+	 * The value is clamped to the declared range and written to the console variable immediately.
+	 * Persisted settings also store it in the container under their key.
+	 *
+	 * @param InIndex The setting index returned by `FindConsoleVariableSetting`.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings (and saves the container) immediately.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Console Variables")
+	void SetConsoleVariableSetting(int32 InIndex, float InValue, bool bApply = true);
+
+	/**
+	 * @brief Retrieves the current value of a console variable setting by name.
+	 *
+	 * Prefer caching the index from `FindConsoleVariableSetting` when called often.
+	 *
+	 * @param InName The setting name.
+	 * @param OutValue Receives the value.
+	 * @return true if the setting is declared.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Console Variables")
+	bool GetConsoleVariableSettingByName(FName InName, float& OutValue) const;
+
+	/**
+	 * @brief Sets the value of a console variable setting by name.
+	 *
+	 * @param InName The setting name.
+	 * @param InValue The value to set.
+	 * @param bApply If true, applies the settings (and saves the container) immediately.
+	 * @return true if the setting is declared.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Console Variables")
+	bool SetConsoleVariableSettingByName(FName InName, float InValue, bool bApply = true);
+
+	/**
+	 * @brief Checks whether the container has finished loading.
+	 *
+	 * Container values can be accessed at any time; accessing them before the load has finished blocks until it is done.
+	 *
+	 * @return True if the container values are available without waiting.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Container")
+	bool IsContainerLoaded() const { return bContainerLoaded; }
+
+	/**
+	 * @brief Blocks until the container has finished loading.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	void WaitForContainerLoad();
+
+	/**
+	 * @brief Blocks until every queued container save has been written to disk.
+	 *
+	 * Container saves are performed on a background task when asynchronous saving is enabled in the developer settings.
+	 * Call this before shutting down or before reading the container file from outside the subsystem.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Container")
+	void FlushPendingSaves();
+
+	/**
+	 * @brief Checks whether a container save is queued or being written.
+	 *
+	 * @return True if there is unfinished save work.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Container")
+	bool HasPendingSaves() const;
 	
+	/**
+	 * @brief Listens to changes of container values within a key range.
+	 *
+	 * Changes are collected during the frame and dispatched once at its end, deduplicated so each category
+	 * is reported once with its latest value. Only changes are reported; read the current values when subscribing.
+	 *
+	 * @param InFirst The first category key (`uint8`) of the range.
+	 * @param InLast The last category key (`uint8`) of the range, inclusive.
+	 * @param InDelegate The listener.
+	 * @return A handle to pass to `RemoveSettingsListener`.
+	 */
+	FDelegateHandle AddContainerValuesListener(uint8 InFirst, uint8 InLast, FEasySettingsValuesChangedDelegate InDelegate);
+
+	/**
+	 * @brief Listens to quality changes of a settings group.
+	 *
+	 * Changes are dispatched once at the end of the frame, no matter how many setters touched the group.
+	 *
+	 * @param InSettingsType The group to listen to.
+	 * @param InDelegate The listener.
+	 * @return A handle to pass to `RemoveSettingsListener`.
+	 */
+	FDelegateHandle AddSettingsGroupListener(ESettingsType InSettingsType, FEasySettingsGroupChangedDelegate InDelegate);
+
+	/**
+	 * @brief Removes a listener added with `AddContainerValuesListener` or `AddSettingsGroupListener`.
+	 *
+	 * @param InHandle The handle returned when the listener was added.
+	 */
+	void RemoveSettingsListener(FDelegateHandle InHandle);
+
+	/**
+	 * @brief Listens to changes of container values within a key range.
+	 *
+	 * Changes are dispatched once at the end of the frame, deduplicated so each category is reported with its latest value.
+	 *
+	 * @param InFirst The first category key (`uint8`) of the range.
+	 * @param InLast The last category key (`uint8`) of the range, inclusive.
+	 * @param InCallback The event to call.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Events")
+	void BindContainerValuesChanged(uint8 InFirst, uint8 InLast, FOnEasySettingsValuesChanged InCallback);
+
+	/**
+	 * @brief Stops listening to container value changes.
+	 *
+	 * @param InCallback The event that was bound.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Events")
+	void UnbindContainerValuesChanged(FOnEasySettingsValuesChanged InCallback);
+
+	/**
+	 * @brief Listens to quality changes of a settings group.
+	 *
+	 * @param InSettingsType The group to listen to.
+	 * @param InCallback The event to call.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Events")
+	void BindSettingsGroupChanged(ESettingsType InSettingsType, FOnEasySettingsGroupChanged InCallback);
+
+	/**
+	 * @brief Stops listening to settings group quality changes.
+	 *
+	 * @param InCallback The event that was bound.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Events")
+	void UnbindSettingsGroupChanged(FOnEasySettingsGroupChanged InCallback);
+
+	/**
+	 * @brief Starts or stops the quality governor.
+	 *
+	 * While enabled, the governor lowers settings groups one step at a time when the frame time stays over budget,
+	 * in the order configured in the developer settings, and raises them back when there is headroom again.
+	 * Governed qualities are applied but never saved. Stopping the governor restores the user choices.
+	 *
+	 * @param bInEnabled Whether the governor should run.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Quality Governor")
+	void SetQualityGovernorEnabled(bool bInEnabled);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Quality Governor")
+	bool IsQualityGovernorEnabled() const { return GovernorTickerHandle.IsValid(); }
+
+	/**
+	 * @brief Retrieves how many steps the governor currently has the settings lowered by.
+	 *
+	 * @return 0 if the user choices are in effect.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Quality Governor")
+	int32 GetQualityGovernorSteps() const { return GovernorSteps.Num(); }
+
+	/**
+	 * @brief Captures the current settings into a profile.
+	 *
+	 * @param InName The profile name.
+	 * @param bIncludeContainer If true, all container values are captured as well.
+	 * @return The captured profile.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Profiles")
+	FEasySettingsProfile CaptureSettingsProfile(FName InName, bool bIncludeContainer = true);
+
+	/**
+	 * @brief Applies a profile with a single apply.
+	 *
+	 * Only the values that differ from the current settings are written, and nothing is applied or saved
+	 * if the profile matches the current settings.
+	 *
+	 * @param InProfile The profile to apply.
+	 * @return The number of values that differed.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Profiles")
+	int32 ApplySettingsProfile(const FEasySettingsProfile& InProfile);
+
+	/**
+	 * @brief Writes a profile to disk, see `UEasySettingsLib::GetSettingsProfilePath`.
+	 *
+	 * @param InProfile The profile to save. Its name is used as the file name.
+	 * @return True if the file was written.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Profiles")
+	bool SaveSettingsProfile(const FEasySettingsProfile& InProfile);
+
+	/**
+	 * @brief Reads a profile saved with `SaveSettingsProfile`.
+	 *
+	 * @param InName The profile name.
+	 * @param OutProfile Receives the profile.
+	 * @return True if the profile exists and could be read.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Profiles")
+	bool LoadSettingsProfile(FName InName, FEasySettingsProfile& OutProfile);
+
+	/**
+	 * @brief Runs the engine hardware benchmark and caches its result for this machine.
+	 *
+	 * Blocks for a moment while rendering the benchmark, call it from a loading screen or a menu.
+	 *
+	 * @param bApply If true, the detected settings are applied in a single batch.
+	 * @return True if the benchmark could run.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Auto Detect")
+	bool RunHardwareBenchmark(bool bApply = true);
+
+	/**
+	 * @brief Retrieves the cached benchmark result, if it was computed on this machine.
+	 *
+	 * @param OutResult Receives the result.
+	 * @return True if a result matching the current hardware and driver exists.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Auto Detect")
+	bool GetCachedHardwareBenchmark(FEasySettingsHardwareBenchmark& OutResult) const;
+
+	/**
+	 * @brief Applies the settings of a benchmark result with a single apply.
+	 *
+	 * @param InResult The benchmark result.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Auto Detect")
+	void ApplyHardwareBenchmark(const FEasySettingsHardwareBenchmark& InResult);
+
+	/**
+	 * @brief Starts measuring the frame cost of every quality level of the configured settings groups.
+	 *
+	 * Opens `CostProfileMap` if one is configured, then steps one group at a time through its quality levels while
+	 * the other groups keep the user settings. Each level is given a warmup, then sampled for a fixed window. The
+	 * results are written as CSV and JSON under `Saved/Profiling/EasySettings` and broadcast through
+	 * `OnSettingsCostProfileFinished`. VSync and the frame rate limit are off during the sweep. Nothing is saved to the
+	 * user config, applying settings while it runs saves the user choices, never the measured level.
+	 *
+	 * Also runs on startup when the command line contains `-EasySettingsProfile`, and exits the application once done.
+	 *
+	 * @return False if a profile is already running or there is nothing to measure.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Cost Profile")
+	bool StartSettingsCostProfile();
+
+	/** @brief Stops a running profile without writing results and restores the user settings. */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Cost Profile")
+	void CancelSettingsCostProfile();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Cost Profile")
+	bool IsSettingsCostProfileRunning() const
+	{
+		return CostProfileTickerHandle.IsValid() || CostProfileMapLoadedHandle.IsValid();
+	}
+
 	/**
 	* Applies the current settings, saving them to the user's configuration file.
+	*
+	* Only the categories that differ from the last applied state are applied: the resolution and window mode,
+	* the scalability groups, VSync, the frame rate limit and the audio quality each have their own engine call.
+	* The user config is only written if one of them changed, and the container is only saved if any of its values
+	* differ from the last persisted state.
 	*/
 	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Misc")
 	void ApplySettings();
+
+	/**
+	 * Applies every `UGameUserSettings` value with `UGameUserSettings::ApplySettings`, changed or not.
+	 *
+	 * Only needed after changing values the subsystem does not manage directly on `UGameUserSettings`.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Misc")
+	void ApplyAllSettings();
+
+	/**
+	 * @brief Checks whether the `UGameUserSettings` values differ from the last applied state.
+	 *
+	 * @return True if the next `ApplySettings` call will apply engine settings.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Misc")
+	bool IsEngineSettingsDirty() const;
+
+	/**
+	 * @brief Checks whether any container value differs from the last persisted state.
+	 *
+	 * @return True if the next `ApplySettings` call will save the container.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Container")
+	bool IsContainerDirty() const;
+
+	/**
+	 * @brief Opens a settings batch.
+	 *
+	 * While a batch is open, every apply requested by the setters (or by `ApplySettings`) is deferred.
+	 * When the outermost batch is committed, the engine settings are applied and the container is saved exactly once.
+	 * Batches can be nested; each call must be paired with `CommitSettingsBatch` or `CancelSettingsBatch`.
+	 *
+	 * @see FEasySettingsBatchScope
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Batch")
+	void BeginSettingsBatch();
+
+	/**
+	 * @brief Closes the innermost settings batch.
+	 *
+	 * If this closes the outermost batch and an apply was requested in the meantime,
+	 * the settings are applied and saved once. If any nested batch was cancelled, the whole batch is rolled back instead.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Batch")
+	void CommitSettingsBatch();
+
+	/**
+	 * @brief Abandons the innermost settings batch.
+	 *
+	 * Marks the batch for rollback. When the outermost batch is closed, engine settings and container values
+	 * are restored to the state they had when the batch was opened and nothing is applied or saved.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameSettingsSubsystem|Batch")
+	void CancelSettingsBatch();
+
+	/**
+	 * @brief Checks whether a settings batch is currently open.
+	 *
+	 * @return True if applies are currently deferred by a batch.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GameSettingsSubsystem|Batch")
+	bool IsSettingsBatchActive() const { return BatchDepth > 0; }
 	
 	/**
 	* Retrieves the UGameUserSettings instance for this game, which manages user-specific graphics and performance settings.
@@ -324,3 +1325,33 @@ public:
 
 
 };
+
+/**
+ * @brief Scoped guard around a settings batch.
+ *
+ * Opens a batch on construction and commits it on destruction, so any number of setter calls inside the scope
+ * result in a single apply and a single container save. Call `Cancel()` to roll the batch back instead.
+ *
+ * @code
+ * {
+ *     FEasySettingsBatchScope batch(subsystem);
+ *     subsystem->SetTextureQuality(3);
+ *     subsystem->SetShadowsQuality(2);
+ * } // applied and saved once here
+ * @endcode
+ */
+class EASYSETTINGS_API FEasySettingsBatchScope
+{
+public:
+	explicit FEasySettingsBatchScope(UEasySettingsSubsystem* InSubsystem);
+	~FEasySettingsBatchScope();
+
+	/** Marks the batch for rollback; it will be closed with `CancelSettingsBatch` when the scope ends. */
+	void Cancel() { bCancelled = true; }
+
+	UE_NONCOPYABLE(FEasySettingsBatchScope);
+
+private:
+	TWeakObjectPtr<UEasySettingsSubsystem> Subsystem;
+	bool bCancelled;
+};